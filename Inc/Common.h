@@ -22,7 +22,11 @@
 #include <string.h>
 
 /* 2. Project Header Files */
+#if defined(HOST_SIM) && HOST_SIM
+#include "host_sim.h" /* fake GPIO and clock for host (x86) builds */
+#else
 #include "main.h"
+#endif
 
 /* Defines & Macros ----------------------------------------------------------*/
 
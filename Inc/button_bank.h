@@ -0,0 +1,190 @@
+/*!
+ *******************************************************************************
+ * @file           : button_bank.h
+ * @author         : KeyhanSalehi
+ * @brief          : Header file for the Button Bank scanner.
+ *******************************************************************************
+ * @attention
+ *
+ * Groups buttons by GPIO port, reads each port's IDR once per scan and
+ * debounces all pins of the port together with bitmask arithmetic.
+ *
+ *******************************************************************************
+ */
+
+#ifndef BUTTON_BANK_H
+#define BUTTON_BANK_H
+
+/* Includes ------------------------------------------------------------------*/
+
+/* 1. System Header Files */
+#include <Common.h>
+/* 2. Project Header Files */
+#include "button_handler.h"
+#include "button_vcounter.h"
+
+/* Defines & Macros ----------------------------------------------------------*/
+
+/*! @def @brief maximum number of GPIO ports a bank can scan. */
+#ifndef BUTTON_BANK_MAX_PORTS
+#define BUTTON_BANK_MAX_PORTS 4
+#endif
+
+/*! @def @brief number of pins on one GPIO port. */
+#define BUTTON_BANK_PORT_PINS 16
+
+/*! @def @brief debounce engines of the bank. */
+#define BUTTON_BANK_ENGINE_MASK 0 /**< Port mask must be stable for DEBOUNCE_DELAY_MS. */
+#define BUTTON_BANK_ENGINE_VCOUNTER 1 /**< Bit-parallel vertical counters. */
+
+/*!
+ * @def   BUTTON_BANK_ENGINE
+ * @brief Debounce engine used by ButtonBank_Scan.
+ * @note  BUTTON_BANK_ENGINE_VCOUNTER samples every BUTTON_BANK_SAMPLE_MS and
+ *        debounces each pin on its own, the same O(1) cost per port.
+ */
+#ifndef BUTTON_BANK_ENGINE
+#define BUTTON_BANK_ENGINE BUTTON_BANK_ENGINE_MASK
+#endif
+
+/*! @def @brief sample period of the vertical counter engine. */
+#ifndef BUTTON_BANK_SAMPLE_MS
+#define BUTTON_BANK_SAMPLE_MS (DEBOUNCE_DELAY_MS / BUTTON_VCOUNTER_SAMPLES)
+#endif
+
+/* Typedefs ------------------------------------------------------------------*/
+
+/*!
+ * @struct
+ * @brief Scan state of all bank buttons living on one GPIO port.
+ * @note  Masks use one bit per pin, a set bit means "pressed".
+ */
+typedef struct {
+	GPIO_TypeDef *port; /**< GPIO port (e.g., GPIOA). */
+	uint16_t pinMask; /**< Pins of this port owned by the bank. */
+	uint16_t activeLowMask; /**< Pins pressed when low (GPIO_PULLUP). */
+#if BUTTON_BANK_ENGINE == BUTTON_BANK_ENGINE_VCOUNTER
+	ButtonVCounter_t vcounter; /**< Lane counters, state is the debounced pressed mask. */
+#else
+	uint16_t lastRaw; /**< Pressed mask of the previous scan. */
+	uint16_t stable; /**< Debounced pressed mask. */
+	softTimer_t debounceTimer; /**< Restarted on any raw change of the port. */
+#endif
+	Button_t *buttons[BUTTON_BANK_PORT_PINS]; /**< Button of each pin bit. */
+	uint16_t chordMask; /**< Chord members, their first press waits for ButtonChord_Update. */
+	uint16_t deferredMask; /**< Members whose first press is not reported yet. */
+} ButtonBankPort_t;
+
+/*!
+ * @struct
+ * @brief Structure to hold a set of buttons scanned port by port.
+ */
+typedef struct {
+	ButtonBankPort_t ports[BUTTON_BANK_MAX_PORTS]; /**< Used port slots. */
+	uint8_t portCount; /**< Number of used port slots. */
+#if BUTTON_BANK_ENGINE == BUTTON_BANK_ENGINE_VCOUNTER
+	softTimer_t sampleTimer; /**< Paces the samples of all ports. */
+#endif
+} ButtonBank_t;
+
+/* Exported Variables --------------------------------------------------------*/
+
+/* 1. Global Variables */
+
+/* Exported Functions (Inline) -----------------------------------------------*/
+
+/*!
+ * @fn     static inline uint16_t ButtonBank_Pressed(const ButtonBankPort_t *bankPort).
+ * @brief  Gets the debounced pressed mask of a port, as of its last sample.
+ * @param  bankPort Pointer to the port slot (ButtonBank_FindPort).
+ * @return uint16_t One bit per pin, set while the pin's button is pressed.
+ */
+static inline uint16_t ButtonBank_Pressed(const ButtonBankPort_t *bankPort) {
+#if BUTTON_BANK_ENGINE == BUTTON_BANK_ENGINE_VCOUNTER
+	return (uint16_t) bankPort->vcounter.state;
+#else
+	return bankPort->stable;
+#endif
+}
+
+/* Exported Functions --------------------------------------------------------*/
+
+/* 1. Global Function Declarations */
+
+/*!
+ * @fn     void ButtonBank_Init(ButtonBank_t *bank).
+ * @brief  Initializes an empty bank.
+ * @param  bank Pointer to the ButtonBank_t structure.
+ * @return void
+ */
+void ButtonBank_Init(ButtonBank_t *bank);
+
+/*!
+ * @fn     return_t ButtonBank_Add(ButtonBank_t *bank, Button_t *button).
+ * @brief  Moves an initialized button under the bank's scan.
+ * @param  bank Pointer to the ButtonBank_t structure.
+ * @param  button Pointer to a Button_t already set up by Button_Init.
+ * @return return_t Returns return_success, or return_failed when the pin is
+ *         not a single pin, already used, or no port slot is left.
+ * @note   The button is no longer read by Button_GetFinalCount, which keeps
+ *         reporting its counts as usual.
+ */
+return_t ButtonBank_Add(ButtonBank_t *bank, Button_t *button);
+
+/*!
+ * @fn     return_t ButtonBank_AddPin(ButtonBank_t *bank, GPIO_TypeDef *port, uint16_t pin, uint32_t pull).
+ * @brief  Adds a pin debounced by the bank without a Button_t.
+ * @param  bank Pointer to the ButtonBank_t structure.
+ * @param  port GPIO port.
+ * @param  pin GPIO pin.
+ * @param  pull Pull configuration (GPIO_PULLUP, GPIO_PULLDOWN, or GPIO_NOPULL).
+ * @return return_t Returns return_success, or return_failed when the pin is
+ *         not a single pin, already used, or no port slot is left.
+ * @note   The pin only shows in ButtonBank_Pressed, for consumers such as
+ *         button_tally.h that keep no per-button state.
+ */
+return_t ButtonBank_AddPin(ButtonBank_t *bank, GPIO_TypeDef *port,
+		uint16_t pin, uint32_t pull);
+
+/*!
+ * @fn     void ButtonBank_Scan(ButtonBank_t *bank).
+ * @brief  Reads every port once and feeds the debounced presses to buttons.
+ * @param  bank Pointer to the ButtonBank_t structure.
+ * @return void
+ * @note   Call it before polling the buttons with Button_GetFinalCount.
+ */
+void ButtonBank_Scan(ButtonBank_t *bank);
+
+/*!
+ * @fn     void ButtonBank_ScanAt(ButtonBank_t *bank, uint32_t now).
+ * @brief  Same as ButtonBank_Scan, with the tick snapshot of the pass.
+ * @param  bank Pointer to the ButtonBank_t structure.
+ * @param  now Tick read once for the whole pass (SOFTTIMER_TICK()).
+ * @return void
+ */
+void ButtonBank_ScanAt(ButtonBank_t *bank, uint32_t now);
+
+/*!
+ * @fn     ButtonBankPort_t* ButtonBank_FindPort(ButtonBank_t *bank, GPIO_TypeDef *port).
+ * @brief  Finds the slot the bank uses for a port.
+ * @param  bank Pointer to the ButtonBank_t structure.
+ * @param  port GPIO port.
+ * @return ButtonBankPort_t* Port slot, or NULL when no button of the port was added.
+ */
+ButtonBankPort_t* ButtonBank_FindPort(ButtonBank_t *bank, GPIO_TypeDef *port);
+
+/*!
+ * @fn     void ButtonBank_Feed(ButtonBankPort_t *bankPort, uint16_t idr, uint32_t tick).
+ * @brief  Debounces one IDR sample of a port taken elsewhere (e.g. by DMA).
+ * @param  bankPort Pointer to the port slot (ButtonBank_FindPort).
+ * @param  idr Raw IDR value of the port.
+ * @param  tick Tick at which the sample was taken.
+ * @return void
+ * @note   Samples must be fed in order. The vertical counter engine expects
+ *         them BUTTON_BANK_SAMPLE_MS apart.
+ */
+void ButtonBank_Feed(ButtonBankPort_t *bankPort, uint16_t idr, uint32_t tick);
+
+#endif /* BUTTON_BANK_H */
+
+/* ******************** (C) COPYRIGHT [KeyhanSalehi] ******************* */
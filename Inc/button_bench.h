@@ -0,0 +1,142 @@
+/*!
+ *******************************************************************************
+ * @file           : button_bench.h
+ * @author         : KeyhanSalehi
+ * @brief          : Header file for the Button Handler cycle benchmark.
+ *******************************************************************************
+ * @attention
+ *
+ * Measures min/avg/max CPU cycles of the polling and bank paths with the
+ * DWT cycle counter, for 1, 8, 32 and 64 buttons, idle and active, and
+ * prints them with printf (retarget it to SWO or a UART).
+ *
+ *******************************************************************************
+ */
+
+#ifndef BUTTON_BENCH_H
+#define BUTTON_BENCH_H
+
+/* Includes ------------------------------------------------------------------*/
+
+/* 1. System Header Files */
+#include <stdio.h>
+#include <Common.h>
+/* 2. Project Header Files */
+#include "button_bank.h"
+
+/* Defines & Macros ----------------------------------------------------------*/
+
+/*!
+ * @def   BUTTON_BENCH_ENABLE
+ * @brief Build the benchmark (1) or leave it out (0).
+ * @note  Needs a core with a DWT cycle counter (Cortex-M3 and up).
+ */
+#ifndef BUTTON_BENCH_ENABLE
+#define BUTTON_BENCH_ENABLE 0
+#endif
+
+#if BUTTON_BENCH_ENABLE
+
+#if defined(__CORTEX_M) && (__CORTEX_M < 3U)
+#error "BUTTON_BENCH_ENABLE needs the DWT cycle counter (Cortex-M3 and up)"
+#endif
+
+/*! @def @brief largest button set measured. */
+#define BUTTON_BENCH_MAX_BUTTONS 64U
+
+/*! @def @brief measured passes per case. */
+#ifndef BUTTON_BENCH_ITERATIONS
+#define BUTTON_BENCH_ITERATIONS 1000U
+#endif
+
+/*! @def @brief output of the report, retarget _write()/fputc() to SWO or UART. */
+#ifndef BUTTON_BENCH_PRINTF
+#define BUTTON_BENCH_PRINTF printf
+#endif
+
+/* Typedefs ------------------------------------------------------------------*/
+
+/*!
+ * @struct
+ * @brief Cycle statistics of one measured case.
+ */
+typedef struct {
+	uint32_t min; /**< Fewest cycles of a pass. */
+	uint32_t max; /**< Most cycles of a pass. */
+	uint64_t total; /**< Sum of all passes. */
+	uint32_t samples; /**< Number of passes. */
+} ButtonBenchStats_t;
+
+/* Exported Variables --------------------------------------------------------*/
+
+/* 1. Global Variables */
+
+/* Exported Functions (Inline) -----------------------------------------------*/
+
+/*!
+ * @fn     static inline uint32_t ButtonBench_Cycles(void).
+ * @brief  Reads the free running DWT cycle counter.
+ * @return uint32_t Current cycle count.
+ */
+static inline uint32_t ButtonBench_Cycles(void) {
+	return DWT->CYCCNT;
+}
+
+/* Exported Functions --------------------------------------------------------*/
+
+/* 1. Global Function Declarations */
+
+/*!
+ * @fn     void ButtonBench_Init(void).
+ * @brief  Enables the DWT cycle counter and measures the read overhead.
+ * @return void
+ */
+void ButtonBench_Init(void);
+
+/*!
+ * @fn     void ButtonBench_Reset(ButtonBenchStats_t *stats).
+ * @brief  Clears the statistics of a case.
+ * @param  stats Pointer to the ButtonBenchStats_t structure.
+ * @return void
+ */
+void ButtonBench_Reset(ButtonBenchStats_t *stats);
+
+/*!
+ * @fn     void ButtonBench_Record(ButtonBenchStats_t *stats, uint32_t start).
+ * @brief  Adds the cycles elapsed since start, less the read overhead.
+ * @param  stats Pointer to the ButtonBenchStats_t structure.
+ * @param  start ButtonBench_Cycles() taken before the measured code.
+ * @return void
+ */
+void ButtonBench_Record(ButtonBenchStats_t *stats, uint32_t start);
+
+/*!
+ * @fn     void ButtonBench_Print(const char *name, uint32_t buttons, const ButtonBenchStats_t *stats).
+ * @brief  Prints one line of the report.
+ * @param  name Name of the case.
+ * @param  buttons Number of buttons of the case.
+ * @param  stats Pointer to the ButtonBenchStats_t structure.
+ * @return void
+ */
+void ButtonBench_Print(const char *name, uint32_t buttons,
+		const ButtonBenchStats_t *stats);
+
+/*!
+ * @fn     void ButtonBench_Run(GPIO_TypeDef *const *ports, uint8_t portCount).
+ * @brief  Measures and prints every case for 1, 8, 32 and 64 buttons.
+ * @param  ports GPIO ports the benchmark buttons are spread on (16 per port).
+ * @param  portCount Number of ports.
+ * @return void
+ * @note   Each case runs idle (released buttons, the fast path) and active
+ *         (name ending in '+', a sequence counting on every button), the
+ *         worst case to size a loop budget with. Bank cases larger than
+ *         16 * portCount (or the bank's BUTTON_BANK_MAX_PORTS) are skipped.
+ *         Call it before the main loop.
+ */
+void ButtonBench_Run(GPIO_TypeDef *const *ports, uint8_t portCount);
+
+#endif /* BUTTON_BENCH_ENABLE */
+
+#endif /* BUTTON_BENCH_H */
+
+/* ******************** (C) COPYRIGHT [KeyhanSalehi] ******************* */
@@ -0,0 +1,118 @@
+/*!
+ *******************************************************************************
+ * @file           : button_capture.h
+ * @author         : KeyhanSalehi
+ * @brief          : Header file for the TIM input-capture edge source.
+ *******************************************************************************
+ * @attention
+ *
+ * A timer channel in input-capture mode on both edges latches the counter
+ * at each transition of the button pin, so edges are timestamped by the
+ * hardware instead of by the interrupt latency. The capture interrupt only
+ * converts the latched value to the softTimer time base and queues the edge
+ * for the same debounce and count engine as the EXTI mode.
+ *
+ * With a microsecond tick (SOFTTIMER_TICK() on a 1 MHz timer and
+ * SOFTTIMER_TICKS_PER_MS at 1000), edge timestamps and the debounce
+ * (Button_SetDebounceTicks) keep microsecond resolution, enough to count
+ * short pulses of sensors wired like buttons. Press durations are still
+ * reported in whole ms.
+ *
+ *******************************************************************************
+ */
+
+#ifndef BUTTON_CAPTURE_H
+#define BUTTON_CAPTURE_H
+
+/* Includes ------------------------------------------------------------------*/
+
+/* 1. System Header Files */
+#include <Common.h>
+/* 2. Project Header Files */
+#include "button_handler.h"
+
+/* Defines & Macros ----------------------------------------------------------*/
+
+/*!
+ * @def   BUTTON_CAPTURE_ENABLE
+ * @brief Build the input-capture edge source (1) or leave it out (0).
+ * @note  Needs the HAL TIM module and BUTTON_EXTI_ENABLE for the edge queue.
+ */
+#ifndef BUTTON_CAPTURE_ENABLE
+#define BUTTON_CAPTURE_ENABLE 0
+#endif
+
+#if BUTTON_CAPTURE_ENABLE
+
+#if !BUTTON_EXTI_ENABLE
+#error "BUTTON_CAPTURE_ENABLE queues its edges in the EXTI edge queue, set BUTTON_EXTI_ENABLE"
+#endif
+
+/*!
+ * @def   BUTTON_CAPTURE_COUNTER_MASK
+ * @brief Range of the capture timer counter (0xFFFF for 16-bit timers,
+ *        0xFFFFFFFF for TIM2/TIM5).
+ * @note  The timer must count at SOFTTIMER_TICKS_PER_MS ticks per ms, and an
+ *        edge must be serviced within one counter period.
+ */
+#ifndef BUTTON_CAPTURE_COUNTER_MASK
+#define BUTTON_CAPTURE_COUNTER_MASK 0xFFFFUL
+#endif
+
+/* Typedefs ------------------------------------------------------------------*/
+
+/*!
+ * @struct
+ * @brief Input-capture channel of one button.
+ */
+typedef struct {
+	Button_t *button; /**< Button fed with the captured edges. */
+	TIM_HandleTypeDef *htim; /**< Capture timer. */
+	uint32_t channel; /**< Capture channel (TIM_CHANNEL_1...). */
+	GPIO_PinState lastState; /**< Pin state after the last captured edge. */
+} ButtonCapture_t;
+
+/* Exported Variables --------------------------------------------------------*/
+
+/* 1. Global Variables */
+
+/* Exported Functions --------------------------------------------------------*/
+
+/* 1. Global Function Declarations */
+
+/*!
+ * @fn     return_t ButtonCapture_Start(ButtonCapture_t *capture, Button_t *button, TIM_HandleTypeDef *htim, uint32_t channel).
+ * @brief  Switches a button to captured edges and starts the channel.
+ * @param  capture Pointer to the ButtonCapture_t structure.
+ * @param  button Pointer to an initialized Button_t on the channel's pin.
+ * @param  htim Capture timer, configured in CubeMx.
+ * @param  channel Capture channel (TIM_CHANNEL_1...), on both edges.
+ * @return return_t Returns return_success or return_failed.
+ */
+return_t ButtonCapture_Start(ButtonCapture_t *capture, Button_t *button,
+		TIM_HandleTypeDef *htim, uint32_t channel);
+
+/*!
+ * @fn     void ButtonCapture_Stop(ButtonCapture_t *capture).
+ * @brief  Stops the capture channel.
+ * @param  capture Pointer to the ButtonCapture_t structure.
+ * @return void
+ */
+void ButtonCapture_Stop(ButtonCapture_t *capture);
+
+/*!
+ * @fn     void ButtonCapture_Callback(ButtonCapture_t *capture).
+ * @brief  Queues the captured edge, call from the capture interrupt.
+ * @param  capture Pointer to the ButtonCapture_t structure.
+ * @return void
+ * @note   Call it from HAL_TIM_IC_CaptureCallback() for the matching timer
+ *         and active channel. The level after each edge is toggled from the
+ *         previous one; after an overcapture it is read back from the pin.
+ */
+void ButtonCapture_Callback(ButtonCapture_t *capture);
+
+#endif /* BUTTON_CAPTURE_ENABLE */
+
+#endif /* BUTTON_CAPTURE_H */
+
+/* ******************** (C) COPYRIGHT [KeyhanSalehi] ******************* */
@@ -0,0 +1,116 @@
+/*!
+ *******************************************************************************
+ * @file           : button_chord.h
+ * @author         : KeyhanSalehi
+ * @brief          : Header file for the Button Chord detector.
+ *******************************************************************************
+ * @attention
+ *
+ * Detects combinations of buttons of one bank port pressed together. All
+ * members are read from the port's debounced pressed mask, one snapshot per
+ * scan, so a chord is a mask compare. A chord takes over the presses of its
+ * members, which then report no clicks of their own; their first press is
+ * held back until the chord window decides, so a consumer never sees
+ * single presses before the chord of the same gesture.
+ *
+ *******************************************************************************
+ */
+
+#ifndef BUTTON_CHORD_H
+#define BUTTON_CHORD_H
+
+/* Includes ------------------------------------------------------------------*/
+
+/* 1. System Header Files */
+#include <Common.h>
+/* 2. Project Header Files */
+#include "button_bank.h"
+
+/* Defines & Macros ----------------------------------------------------------*/
+
+/*! @def @brief Define for the time all chord members must be pressed within (80ms).*/
+#ifndef BUTTON_CHORD_WINDOW_MS
+#define BUTTON_CHORD_WINDOW_MS 80
+#endif
+
+/* Typedefs ------------------------------------------------------------------*/
+
+/*!
+ * @struct
+ * @brief One registered chord.
+ */
+typedef struct {
+	uint16_t mask; /**< Pins of the member buttons on the port. */
+	uint8_t id; /**< Chord id reported on detection. */
+} ButtonChord_t;
+
+/*!
+ * @struct
+ * @brief Chord detector of one bank port.
+ */
+typedef struct {
+	const ButtonChord_t *chords; /**< Registered chords. */
+	size_t count; /**< Number of registered chords. */
+	ButtonBankPort_t *bankPort; /**< Port slot the members live on. */
+	uint16_t lastPressed; /**< Pressed mask of the previous update. */
+	uint16_t latched; /**< Members of the detected chord, until all are released. */
+	bool isWindowOpen; /**< First press seen, chord not resolved yet. */
+	volatile bool isPending; /**< Chord not yet read by ButtonChord_Get. */
+	uint8_t pendingId; /**< Id of the last detected chord. */
+	softTimer_t windowTimer; /**< Tick of the first press of the window. */
+} ButtonChords_t;
+
+/* Exported Variables --------------------------------------------------------*/
+
+/* 1. Global Variables */
+
+/* Exported Functions --------------------------------------------------------*/
+
+/* 1. Global Function Declarations */
+
+/*!
+ * @fn     void ButtonChord_Init(ButtonChords_t *detector, ButtonBankPort_t *bankPort, const ButtonChord_t *chords, size_t count).
+ * @brief  Initializes the chord detector of a bank port.
+ * @param  detector Pointer to the ButtonChords_t structure.
+ * @param  bankPort Pointer to the port slot (ButtonBank_FindPort).
+ * @param  chords Const table of the chords.
+ * @param  count Number of chords in the table.
+ * @return void
+ */
+void ButtonChord_Init(ButtonChords_t *detector, ButtonBankPort_t *bankPort,
+		const ButtonChord_t *chords, size_t count);
+
+/*!
+ * @fn     void ButtonChord_Update(ButtonChords_t *detector).
+ * @brief  Resolves chords from the pressed mask of the last scan.
+ * @param  detector Pointer to the ButtonChords_t structure.
+ * @return void
+ * @note   Call it right after ButtonBank_Scan and before polling the buttons,
+ *         in the same context: it pushes to the queue of Button_SetEventQueue.
+ *         A chord is resolved BUTTON_CHORD_WINDOW_MS after its first member
+ *         press, when exactly its members are pressed, and published as
+ *         BUTTON_EVENT_CHORD.
+ */
+void ButtonChord_Update(ButtonChords_t *detector);
+
+/*!
+ * @fn     void ButtonChord_UpdateAt(ButtonChords_t *detector, uint32_t now).
+ * @brief  Same as ButtonChord_Update, with the tick snapshot of the pass.
+ * @param  detector Pointer to the ButtonChords_t structure.
+ * @param  now Tick read once for the whole pass (SOFTTIMER_TICK()).
+ * @return void
+ */
+void ButtonChord_UpdateAt(ButtonChords_t *detector, uint32_t now);
+
+/*!
+ * @fn     return_t ButtonChord_Get(ButtonChords_t *detector, uint8_t *id).
+ * @brief  Reports a detected chord once.
+ * @param  detector Pointer to the ButtonChords_t structure.
+ * @param  id Pointer to store the chord id.
+ * @return return_t Returns return_success once per chord, return_busy otherwise.
+ */
+return_t ButtonChord_Get(ButtonChords_t *detector, uint8_t *id);
+
+#endif /* BUTTON_CHORD_H */
+
+/* ******************** (C) COPYRIGHT [KeyhanSalehi] ******************* */
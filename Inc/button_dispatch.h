@@ -0,0 +1,152 @@
+/*!
+ *******************************************************************************
+ * @file           : button_dispatch.h
+ * @author         : KeyhanSalehi
+ * @brief          : Header file for the Button Event dispatcher.
+ *******************************************************************************
+ * @attention
+ *
+ * Replaces the application's "if (count == 1) ... else if (count == 2)"
+ * chains with const callback tables, one per button id. An event selects
+ * its callback with two array lookups (button id, then push count or event
+ * kind), so dispatching costs the same for any number of buttons:
+ *
+ *   static const ButtonCallbacks_t keyCallbacks = {
+ *       .onClicks = { [1] = Key_OnClick, [2] = Key_OnDoubleClick },
+ *       .onEvent = { [BUTTON_EVENT_LONG_PRESS] = Key_OnLongPress },
+ *   };
+ *   static const ButtonCallbacks_t *const callbacks[] = { [KEY_ID] = &keyCallbacks };
+ *
+ * With BUTTON_DISPATCH_DEFER the producer context (e.g. SysTick running
+ * Button_Process) only pends PendSV, and the callbacks run from
+ * PendSV_Handler at the lowest priority.
+ *
+ *******************************************************************************
+ */
+
+#ifndef BUTTON_DISPATCH_H
+#define BUTTON_DISPATCH_H
+
+/* Includes ------------------------------------------------------------------*/
+
+/* 1. System Header Files */
+#include <Common.h>
+/* 2. Project Header Files */
+#include "button_handler.h"
+#include "button_event.h"
+
+/* Defines & Macros ----------------------------------------------------------*/
+
+/*! @def @brief size of the click table, indexed by push count (PUSH_COUNT_MAX + 1). */
+#ifndef BUTTON_DISPATCH_CLICKS
+#define BUTTON_DISPATCH_CLICKS (PUSH_COUNT_MAX + 1)
+#endif
+
+/*! @def @brief events taken from the queue per batch. */
+#ifndef BUTTON_DISPATCH_BATCH
+#define BUTTON_DISPATCH_BATCH 4U
+#endif
+
+/*!
+ * @def   BUTTON_DISPATCH_DEFER
+ * @brief Run the callbacks from a pended low-priority interrupt (1) or from
+ *        the caller of ButtonDispatch_Run (0).
+ * @note  FreeRTOS owns PendSV: point BUTTON_DISPATCH_PEND at an unused IRQ
+ *        (NVIC_SetPendingIRQ) or use button_rtos.h instead.
+ */
+#ifndef BUTTON_DISPATCH_DEFER
+#define BUTTON_DISPATCH_DEFER 0
+#endif
+
+#if BUTTON_DISPATCH_DEFER
+/*! @def @brief pends the interrupt running ButtonDispatch_Run. */
+#ifndef BUTTON_DISPATCH_PEND
+#define BUTTON_DISPATCH_PEND() (SCB->ICSR = SCB_ICSR_PENDSVSET_Msk)
+#endif
+#endif
+
+/* Typedefs ------------------------------------------------------------------*/
+
+/*!
+ * @brief Callback of one event.
+ * @param event Event being dispatched.
+ */
+typedef void (*ButtonCallback_t)(const ButtonEvent_t *event);
+
+/*!
+ * @struct
+ * @brief Callbacks of one button, NULL entries are ignored.
+ */
+typedef struct {
+	ButtonCallback_t onClicks[BUTTON_DISPATCH_CLICKS]; /**< BUTTON_EVENT_CLICKS, indexed by push count. */
+	ButtonCallback_t onEvent[BUTTON_EVENT_TYPE_COUNT]; /**< Indexed by event kind, [BUTTON_EVENT_CLICKS] catches counts without an onClicks entry. */
+} ButtonCallbacks_t;
+
+/*!
+ * @struct
+ * @brief Dispatcher draining one event queue.
+ */
+typedef struct {
+	ButtonEventQueue_t *queue; /**< Queue the events are taken from. */
+	const ButtonCallbacks_t *const *tables; /**< Callback tables, indexed by button id. */
+	size_t count; /**< Number of tables. */
+	uint32_t unhandled; /**< Events without a callback. */
+} ButtonDispatch_t;
+
+/* Exported Variables --------------------------------------------------------*/
+
+/* 1. Global Variables */
+
+/* Exported Functions --------------------------------------------------------*/
+
+/* 1. Global Function Declarations */
+
+/*!
+ * @fn     void ButtonDispatch_Init(ButtonDispatch_t *dispatch, ButtonEventQueue_t *queue, const ButtonCallbacks_t *const *tables, size_t count).
+ * @brief  Initializes a dispatcher.
+ * @param  dispatch Pointer to the ButtonDispatch_t structure.
+ * @param  queue Pointer to the event queue (Button_SetEventQueue).
+ * @param  tables Callback tables indexed by button id (Button_SetId), NULL
+ *         entries for ids without callbacks.
+ * @param  count Number of tables.
+ * @return void
+ */
+void ButtonDispatch_Init(ButtonDispatch_t *dispatch, ButtonEventQueue_t *queue,
+		const ButtonCallbacks_t *const *tables, size_t count);
+
+/*!
+ * @fn     return_t ButtonDispatch_Event(ButtonDispatch_t *dispatch, const ButtonEvent_t *event).
+ * @brief  Calls the callback of one event.
+ * @param  dispatch Pointer to the ButtonDispatch_t structure.
+ * @param  event Event to dispatch.
+ * @return return_t Returns return_success, or return_failed when the event
+ *         has no callback.
+ * @note   Lets events of other sources (e.g. button_rtos.h) use the tables.
+ */
+return_t ButtonDispatch_Event(ButtonDispatch_t *dispatch,
+		const ButtonEvent_t *event);
+
+/*!
+ * @fn     size_t ButtonDispatch_Run(ButtonDispatch_t *dispatch).
+ * @brief  Drains the queue and dispatches every event.
+ * @param  dispatch Pointer to the ButtonDispatch_t structure.
+ * @return size_t Number of events taken from the queue.
+ * @note   Consumer side of the queue: call it from the main loop, or from
+ *         PendSV_Handler with BUTTON_DISPATCH_DEFER.
+ */
+size_t ButtonDispatch_Run(ButtonDispatch_t *dispatch);
+
+#if BUTTON_DISPATCH_DEFER
+/*!
+ * @fn     void ButtonDispatch_Request(const ButtonDispatch_t *dispatch).
+ * @brief  Pends the dispatch interrupt when events are waiting.
+ * @param  dispatch Pointer to the ButtonDispatch_t structure.
+ * @return void
+ * @note   Call it at the end of the producer pass (after Button_Process).
+ */
+void ButtonDispatch_Request(const ButtonDispatch_t *dispatch);
+#endif
+
+#endif /* BUTTON_DISPATCH_H */
+
+/* ******************** (C) COPYRIGHT [KeyhanSalehi] ******************* */
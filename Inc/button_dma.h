@@ -0,0 +1,130 @@
+/*!
+ *******************************************************************************
+ * @file           : button_dma.h
+ * @author         : KeyhanSalehi
+ * @brief          : Header file for the DMA sampler of the Button Bank.
+ *******************************************************************************
+ * @attention
+ *
+ * A hardware timer triggers DMA reads of one port's IDR into a circular
+ * buffer at a fixed rate. Each half of the buffer is debounced in a batch
+ * by the bank on the DMA half/full-transfer interrupts, so the sample rate
+ * no longer depends on the main loop.
+ *
+ *******************************************************************************
+ */
+
+#ifndef BUTTON_DMA_H
+#define BUTTON_DMA_H
+
+/* Includes ------------------------------------------------------------------*/
+
+/* 1. System Header Files */
+#include <Common.h>
+/* 2. Project Header Files */
+#include "button_bank.h"
+
+/* Defines & Macros ----------------------------------------------------------*/
+
+/*!
+ * @def   BUTTON_DMA_ENABLE
+ * @brief Build the DMA sampler (1) or leave it out (0).
+ * @note  Needs the HAL TIM and DMA modules.
+ */
+#ifndef BUTTON_DMA_ENABLE
+#define BUTTON_DMA_ENABLE 0
+#endif
+
+#if BUTTON_DMA_ENABLE
+
+/*! @def @brief samples in the circular buffer, processed half by half (even). */
+#ifndef BUTTON_DMA_BUFFER_SIZE
+#define BUTTON_DMA_BUFFER_SIZE 16U
+#endif
+
+#if (BUTTON_DMA_BUFFER_SIZE % 2U) != 0U
+#error "BUTTON_DMA_BUFFER_SIZE must be even"
+#endif
+
+/*!
+ * @def   BUTTON_DMA_SAMPLE_MS
+ * @brief Period of the timer triggering the DMA, in ms.
+ * @note  Must match the timer configuration. The vertical counter engine
+ *        needs BUTTON_BANK_SAMPLE_MS.
+ */
+#ifndef BUTTON_DMA_SAMPLE_MS
+#if BUTTON_BANK_ENGINE == BUTTON_BANK_ENGINE_VCOUNTER
+#define BUTTON_DMA_SAMPLE_MS BUTTON_BANK_SAMPLE_MS
+#else
+#define BUTTON_DMA_SAMPLE_MS 1U
+#endif
+#endif
+
+/*! @def @brief maximum number of DMA samplers running at once. */
+#ifndef BUTTON_DMA_MAX_STREAMS
+#define BUTTON_DMA_MAX_STREAMS BUTTON_BANK_MAX_PORTS
+#endif
+
+/* Typedefs ------------------------------------------------------------------*/
+
+/*!
+ * @struct
+ * @brief DMA sampler of one bank port.
+ */
+typedef struct {
+	uint16_t samples[BUTTON_DMA_BUFFER_SIZE]; /**< Circular buffer written by the DMA. */
+	ButtonBankPort_t *bankPort; /**< Port slot the samples are fed to. */
+	TIM_HandleTypeDef *htim; /**< Timer triggering the DMA. */
+	DMA_HandleTypeDef *hdma; /**< DMA stream linked to the timer update. */
+	uint32_t sampleTick; /**< Tick of the last sample fed. */
+} ButtonDma_t;
+
+/* Exported Variables --------------------------------------------------------*/
+
+/* 1. Global Variables */
+
+/* Exported Functions --------------------------------------------------------*/
+
+/* 1. Global Function Declarations */
+
+/*!
+ * @fn     return_t ButtonDma_Init(ButtonDma_t *dma, ButtonBank_t *bank, GPIO_TypeDef *port).
+ * @brief  Binds a sampler to the port slot of a bank.
+ * @param  dma Pointer to the ButtonDma_t structure.
+ * @param  bank Pointer to the ButtonBank_t structure.
+ * @param  port GPIO port to sample.
+ * @return return_t Returns return_success, or return_failed when no button
+ *         of the port was added to the bank.
+ * @note   Add the port's buttons with ButtonBank_Add first, and do not
+ *         ButtonBank_Scan that port any more.
+ */
+return_t ButtonDma_Init(ButtonDma_t *dma, ButtonBank_t *bank,
+		GPIO_TypeDef *port);
+
+/*!
+ * @fn     return_t ButtonDma_Start(ButtonDma_t *dma, TIM_HandleTypeDef *htim).
+ * @brief  Starts the timer-triggered DMA reads of the port's IDR.
+ * @param  dma Pointer to the ButtonDma_t structure.
+ * @param  htim Timer whose update event has a DMA stream linked in CubeMx.
+ * @return return_t Returns return_success, or return_failed when the timer
+ *         has no update DMA, all streams are used or the HAL fails.
+ * @note   Configure the DMA stream as peripheral to memory, half-word,
+ *         circular, and the timer to BUTTON_DMA_SAMPLE_MS. Presses are fed
+ *         from the DMA interrupt: run Button_Process (or Button_GetFinalCount)
+ *         at the same interrupt priority.
+ */
+return_t ButtonDma_Start(ButtonDma_t *dma, TIM_HandleTypeDef *htim);
+
+/*!
+ * @fn     void ButtonDma_Stop(ButtonDma_t *dma).
+ * @brief  Stops the timer and the DMA of a started sampler.
+ * @param  dma Pointer to the ButtonDma_t structure.
+ * @return void
+ */
+void ButtonDma_Stop(ButtonDma_t *dma);
+
+#endif /* BUTTON_DMA_ENABLE */
+
+#endif /* BUTTON_DMA_H */
+
+/* ******************** (C) COPYRIGHT [KeyhanSalehi] ******************* */
@@ -0,0 +1,145 @@
+/*!
+ *******************************************************************************
+ * @file           : button_encoder.h
+ * @author         : KeyhanSalehi
+ * @brief          : Header file for the Rotary Encoder decoder.
+ *******************************************************************************
+ * @attention
+ *
+ * Decodes a quadrature encoder with a 16-entry transition table, either from
+ * its two GPIO pins or from a timer in encoder mode, and publishes the
+ * detents turned as events on an event queue of its own, because it is
+ * usually updated from an interrupt while the buttons are processed
+ * elsewhere (an event queue has a single producer context).
+ *
+ *******************************************************************************
+ */
+
+#ifndef BUTTON_ENCODER_H
+#define BUTTON_ENCODER_H
+
+/* Includes ------------------------------------------------------------------*/
+
+/* 1. System Header Files */
+#include <Common.h>
+/* 2. Project Header Files */
+#include "button_handler.h"
+
+/* Defines & Macros ----------------------------------------------------------*/
+
+/*! @def @brief quadrature steps between two detents (4 for most encoders). */
+#ifndef BUTTON_ENCODER_STEPS_PER_DETENT
+#define BUTTON_ENCODER_STEPS_PER_DETENT 4
+#endif
+
+/*!
+ * @def   BUTTON_ENCODER_TIM_ENABLE
+ * @brief Build the timer encoder mode backend (1) or leave it out (0).
+ * @note  Needs the HAL TIM module.
+ */
+#ifndef BUTTON_ENCODER_TIM_ENABLE
+#define BUTTON_ENCODER_TIM_ENABLE 0
+#endif
+
+/* Typedefs ------------------------------------------------------------------*/
+
+/*!
+ * @struct
+ * @brief State of one rotary encoder.
+ */
+typedef struct {
+	GPIO_TypeDef *portA; /**< GPIO port of channel A (NULL in timer mode). */
+	GPIO_TypeDef *portB; /**< GPIO port of channel B. */
+	uint16_t pinA; /**< GPIO pin of channel A. */
+	uint16_t pinB; /**< GPIO pin of channel B. */
+#if BUTTON_ENCODER_TIM_ENABLE
+	TIM_HandleTypeDef *htim; /**< Timer in encoder mode, or NULL. */
+	uint16_t lastCount; /**< Timer counter at the previous update. */
+#endif
+	ButtonEventQueue_t *queue; /**< Queue of the rotation events, or NULL. */
+	int32_t position; /**< Detents turned since init, clockwise positive. */
+	int16_t steps; /**< Quadrature steps not yet making a detent. */
+	uint8_t state; /**< Last A/B levels (A in bit 1). */
+	uint8_t id; /**< Id reported in events. */
+} ButtonEncoder_t;
+
+/* Exported Variables --------------------------------------------------------*/
+
+/* 1. Global Variables */
+
+/* Exported Functions --------------------------------------------------------*/
+
+/* 1. Global Function Declarations */
+
+/*!
+ * @fn     void ButtonEncoder_Init(ButtonEncoder_t *encoder, GPIO_TypeDef *portA, uint16_t pinA, GPIO_TypeDef *portB, uint16_t pinB).
+ * @brief  Initializes an encoder decoded from its GPIO pins.
+ * @param  encoder Pointer to the ButtonEncoder_t structure.
+ * @param  portA GPIO port of channel A.
+ * @param  pinA GPIO pin of channel A.
+ * @param  portB GPIO port of channel B.
+ * @param  pinB GPIO pin of channel B.
+ * @return void
+ */
+void ButtonEncoder_Init(ButtonEncoder_t *encoder, GPIO_TypeDef *portA,
+		uint16_t pinA, GPIO_TypeDef *portB, uint16_t pinB);
+
+#if BUTTON_ENCODER_TIM_ENABLE
+/*!
+ * @fn     return_t ButtonEncoder_InitTim(ButtonEncoder_t *encoder, TIM_HandleTypeDef *htim).
+ * @brief  Initializes an encoder counted by a timer in encoder mode.
+ * @param  encoder Pointer to the ButtonEncoder_t structure.
+ * @param  htim Timer configured in TIM_ENCODERMODE_TI12 (e.g., by CubeMX).
+ * @return return_t Returns return_success, or return_failed when the timer
+ *         does not start.
+ */
+return_t ButtonEncoder_InitTim(ButtonEncoder_t *encoder,
+		TIM_HandleTypeDef *htim);
+#endif
+
+/*!
+ * @fn     void ButtonEncoder_SetId(ButtonEncoder_t *encoder, uint8_t id).
+ * @brief  Sets the id the encoder reports in its events.
+ * @param  encoder Pointer to the ButtonEncoder_t structure.
+ * @param  id Encoder id.
+ * @return void
+ */
+void ButtonEncoder_SetId(ButtonEncoder_t *encoder, uint8_t id);
+
+/*!
+ * @fn     void ButtonEncoder_SetEventQueue(ButtonEncoder_t *encoder, ButtonEventQueue_t *queue).
+ * @brief  Sets the queue the encoder publishes its rotation events to.
+ * @param  encoder Pointer to the ButtonEncoder_t structure.
+ * @param  queue Pointer to an initialized ButtonEventQueue_t, or NULL.
+ * @return void
+ * @note   The encoder must be the only producer of the queue unless every
+ *         producer runs in its context; use the queue of
+ *         Button_SetEventQueue only when ButtonEncoder_Update runs where
+ *         the buttons are processed.
+ */
+void ButtonEncoder_SetEventQueue(ButtonEncoder_t *encoder,
+		ButtonEventQueue_t *queue);
+
+/*!
+ * @fn     int32_t ButtonEncoder_Update(ButtonEncoder_t *encoder).
+ * @brief  Decodes the encoder and publishes the detents turned.
+ * @param  encoder Pointer to the ButtonEncoder_t structure.
+ * @return int32_t Detents turned since the previous update, clockwise positive.
+ * @note   In GPIO mode call it faster than the pins change (e.g., every 1ms
+ *         in SysTick_Handler, or from the EXTI of both pins), a missed step
+ *         is lost. Events go to the queue of ButtonEncoder_SetEventQueue,
+ *         count holds the detents of this update.
+ */
+int32_t ButtonEncoder_Update(ButtonEncoder_t *encoder);
+
+/*!
+ * @fn     int32_t ButtonEncoder_GetPosition(const ButtonEncoder_t *encoder).
+ * @brief  Gets the detents turned since init.
+ * @param  encoder Pointer to the ButtonEncoder_t structure.
+ * @return int32_t Position in detents, clockwise positive.
+ */
+int32_t ButtonEncoder_GetPosition(const ButtonEncoder_t *encoder);
+
+#endif /* BUTTON_ENCODER_H */
+
+/* ******************** (C) COPYRIGHT [KeyhanSalehi] ******************* */
@@ -0,0 +1,167 @@
+/*!
+ *******************************************************************************
+ * @file           : button_event.h
+ * @author         : KeyhanSalehi
+ * @brief          : Header file for the Button Event queue.
+ *******************************************************************************
+ * @attention
+ *
+ * Fixed-capacity, lock-free single-producer/single-consumer ring buffer of
+ * button events. The button engine (e.g. Button_Process from SysTick)
+ * produces, the main loop or a task drains the events in batches.
+ *
+ * All producers of one queue must run in one context, or in interrupts of
+ * one priority that cannot preempt each other: Button_Process and
+ * Button_GetFinalCount, the presses fed by ButtonBank_Scan, ButtonMatrix_Scan
+ * or the DMA sampler, ButtonChord_Update and ButtonTally_Update all push to
+ * the queue of Button_SetEventQueue. Give a producer in another context,
+ * e.g. an encoder updated from an interrupt, a queue of its own.
+ *
+ *******************************************************************************
+ */
+
+#ifndef BUTTON_EVENT_H
+#define BUTTON_EVENT_H
+
+/* Includes ------------------------------------------------------------------*/
+
+/* 1. System Header Files */
+#include <Common.h>
+/* 2. Project Header Files */
+
+/* Defines & Macros ----------------------------------------------------------*/
+
+/*! @def @brief number of events a queue can hold (power of 2). */
+#ifndef BUTTON_EVENT_QUEUE_SIZE
+#define BUTTON_EVENT_QUEUE_SIZE 16U
+#endif
+
+#if (BUTTON_EVENT_QUEUE_SIZE & (BUTTON_EVENT_QUEUE_SIZE - 1U)) != 0U
+#error "BUTTON_EVENT_QUEUE_SIZE must be a power of 2"
+#endif
+
+/*!
+ * @def   BUTTON_EVENT_BARRIER
+ * @brief Memory barrier between writing an event and publishing its index.
+ */
+#ifndef BUTTON_EVENT_BARRIER
+#define BUTTON_EVENT_BARRIER() __DMB()
+#endif
+
+/*!
+ * @def   BUTTON_EVENT_CHECK_PRODUCER
+ * @brief Refuse pushes from another context than the first push of the
+ *        queue (1), or trust the callers (0).
+ * @note  Debug aid. It compares the active exception number, so it also
+ *        refuses two interrupts of one priority, and cannot tell two tasks
+ *        apart.
+ */
+#ifndef BUTTON_EVENT_CHECK_PRODUCER
+#define BUTTON_EVENT_CHECK_PRODUCER 0
+#endif
+
+#if BUTTON_EVENT_CHECK_PRODUCER
+/*! @def @brief id of the running context (0 in thread mode). */
+#ifndef BUTTON_EVENT_CONTEXT
+#define BUTTON_EVENT_CONTEXT() __get_IPSR()
+#endif
+
+/*! @def @brief producer of a queue nothing was pushed to yet. */
+#define BUTTON_EVENT_NO_PRODUCER UINT32_MAX
+#endif
+
+/* Typedefs ------------------------------------------------------------------*/
+
+/*!
+ * @enum
+ * @brief Kind of a button event.
+ */
+typedef enum {
+	BUTTON_EVENT_CLICKS, /**< A push sequence closed with a valid count. */
+	BUTTON_EVENT_PRESS, /**< First debounced press of a sequence, sent at once. */
+	BUTTON_EVENT_LONG_PRESS, /**< Button held for its long press time, count holds the preceding clicks. */
+	BUTTON_EVENT_REPEAT, /**< Auto-repeat while held, count is the repeat number. */
+	BUTTON_EVENT_ROTATE_CW, /**< Encoder turned clockwise, count is the number of detents. */
+	BUTTON_EVENT_ROTATE_CCW, /**< Encoder turned counter-clockwise, count is the number of detents. */
+	BUTTON_EVENT_CHORD, /**< Buttons pressed together, id is the chord id (button_chord.h). */
+	BUTTON_EVENT_TYPE_COUNT, /**< Number of event kinds, not an event. */
+} ButtonEventType_t;
+
+/*!
+ * @struct
+ * @brief One button event.
+ */
+typedef struct {
+	uint32_t timestamp; /**< Tick the event was produced at. */
+	uint16_t duration; /**< Duration of the last press, or time held so far, in ms (0 if unknown). */
+	uint8_t id; /**< Id of the button (Button_SetId). */
+	uint8_t type; /**< Event kind (ButtonEventType_t). */
+	uint8_t count; /**< Push count of the sequence (repeat number for BUTTON_EVENT_REPEAT). */
+} ButtonEvent_t;
+
+/*!
+ * @struct
+ * @brief Single-producer/single-consumer event ring buffer.
+ * @note  head is only written by the producer, tail only by the consumer.
+ */
+typedef struct {
+	ButtonEvent_t events[BUTTON_EVENT_QUEUE_SIZE]; /**< Event storage. */
+	volatile uint32_t head; /**< Free-running write counter. */
+	volatile uint32_t tail; /**< Free-running read counter. */
+	volatile uint32_t dropped; /**< Events lost because the queue was full. */
+#if BUTTON_EVENT_CHECK_PRODUCER
+	uint32_t producer; /**< Context of the first push (BUTTON_EVENT_CONTEXT). */
+	volatile uint32_t wrongContext; /**< Pushes refused from another context. */
+#endif
+} ButtonEventQueue_t;
+
+/* Exported Variables --------------------------------------------------------*/
+
+/* 1. Global Variables */
+
+/* Exported Functions --------------------------------------------------------*/
+
+/* 1. Global Function Declarations */
+
+/*!
+ * @fn     void ButtonEvent_Init(ButtonEventQueue_t *queue).
+ * @brief  Initializes an empty event queue.
+ * @param  queue Pointer to the ButtonEventQueue_t structure.
+ * @return void
+ */
+void ButtonEvent_Init(ButtonEventQueue_t *queue);
+
+/*!
+ * @fn     return_t ButtonEvent_Push(ButtonEventQueue_t *queue, const ButtonEvent_t *event).
+ * @brief  Appends an event, producer side only.
+ * @param  queue Pointer to the ButtonEventQueue_t structure.
+ * @param  event Event to copy into the queue.
+ * @return return_t Returns return_success, or return_failed when the queue is
+ *         full (or, with BUTTON_EVENT_CHECK_PRODUCER, pushed from another
+ *         context than its producer).
+ */
+return_t ButtonEvent_Push(ButtonEventQueue_t *queue, const ButtonEvent_t *event);
+
+/*!
+ * @fn     return_t ButtonEvent_Pop(ButtonEventQueue_t *queue, ButtonEvent_t *event).
+ * @brief  Takes the oldest event, consumer side only.
+ * @param  queue Pointer to the ButtonEventQueue_t structure.
+ * @param  event Pointer to store the event.
+ * @return return_t Returns return_success, or return_busy when the queue is empty.
+ */
+return_t ButtonEvent_Pop(ButtonEventQueue_t *queue, ButtonEvent_t *event);
+
+/*!
+ * @fn     size_t ButtonEvent_PopBatch(ButtonEventQueue_t *queue, ButtonEvent_t *events, size_t maxEvents).
+ * @brief  Takes up to maxEvents of the oldest events at once, consumer side only.
+ * @param  queue Pointer to the ButtonEventQueue_t structure.
+ * @param  events Array to store the events.
+ * @param  maxEvents Capacity of the events array.
+ * @return size_t Number of events stored.
+ */
+size_t ButtonEvent_PopBatch(ButtonEventQueue_t *queue, ButtonEvent_t *events,
+		size_t maxEvents);
+
+#endif /* BUTTON_EVENT_H */
+
+/* ******************** (C) COPYRIGHT [KeyhanSalehi] ******************* */
@@ -0,0 +1,136 @@
+/*!
+ *******************************************************************************
+ * @file           : button_gesture.h
+ * @author         : KeyhanSalehi
+ * @brief          : Header file for the Button Gesture matcher.
+ *******************************************************************************
+ * @attention
+ *
+ * With BUTTON_GESTURE_ENABLE the engine records every sequence as a code of
+ * 2-bit symbols (short press, long press, pause) behind a leading 1 bit, so
+ * the code of "short, long, short" is 0b1'01'10'01. Codes are built at
+ * compile time with BUTTON_GESTURE_CODEn, and a const table sorted by code
+ * maps them to command ids with a binary search:
+ *
+ *   static const ButtonGesture_t gestures[] = {   (sorted by code)
+ *       { BUTTON_GESTURE_CODE1(BUTTON_GESTURE_SHORT), CMD_NEXT },
+ *       { BUTTON_GESTURE_CODE2(BUTTON_GESTURE_SHORT, BUTTON_GESTURE_LONG), CMD_MENU },
+ *       { BUTTON_GESTURE_CODE3(BUTTON_GESTURE_SHORT, BUTTON_GESTURE_PAUSE,
+ *               BUTTON_GESTURE_SHORT), CMD_SERVICE },
+ *   };
+ *
+ *******************************************************************************
+ */
+
+#ifndef BUTTON_GESTURE_H
+#define BUTTON_GESTURE_H
+
+/* Includes ------------------------------------------------------------------*/
+
+/* 1. System Header Files */
+#include <Common.h>
+/* 2. Project Header Files */
+#include "button_handler.h"
+
+/* Defines & Macros ----------------------------------------------------------*/
+
+/*! @def @brief gesture symbols. */
+#define BUTTON_GESTURE_SHORT 1U /**< Press shorter than BUTTON_GESTURE_LONG_MS. */
+#define BUTTON_GESTURE_LONG 2U /**< Press of BUTTON_GESTURE_LONG_MS or more. */
+#define BUTTON_GESTURE_PAUSE 3U /**< Gap of BUTTON_GESTURE_PAUSE_MS or more between two presses. */
+
+/*! @def @brief bits of one symbol. */
+#define BUTTON_GESTURE_SYMBOL_BITS 2U
+
+/*! @def @brief code of an empty gesture (the leading 1 bit). */
+#define BUTTON_GESTURE_EMPTY 1UL
+
+/*! @def @brief most symbols a 32-bit code holds. */
+#define BUTTON_GESTURE_MAX_SYMBOLS 15U
+
+/*! @def @brief appends a symbol to a code. */
+#define BUTTON_GESTURE_APPEND(code, symbol) \
+		(((uint32_t) (code) << BUTTON_GESTURE_SYMBOL_BITS) | (uint32_t) (symbol))
+
+/*! @def @brief codes of gestures of 1 to 8 symbols. */
+#define BUTTON_GESTURE_CODE1(s1) \
+		BUTTON_GESTURE_APPEND(BUTTON_GESTURE_EMPTY, s1)
+#define BUTTON_GESTURE_CODE2(s1, s2) \
+		BUTTON_GESTURE_APPEND(BUTTON_GESTURE_CODE1(s1), s2)
+#define BUTTON_GESTURE_CODE3(s1, s2, s3) \
+		BUTTON_GESTURE_APPEND(BUTTON_GESTURE_CODE2(s1, s2), s3)
+#define BUTTON_GESTURE_CODE4(s1, s2, s3, s4) \
+		BUTTON_GESTURE_APPEND(BUTTON_GESTURE_CODE3(s1, s2, s3), s4)
+#define BUTTON_GESTURE_CODE5(s1, s2, s3, s4, s5) \
+		BUTTON_GESTURE_APPEND(BUTTON_GESTURE_CODE4(s1, s2, s3, s4), s5)
+#define BUTTON_GESTURE_CODE6(s1, s2, s3, s4, s5, s6) \
+		BUTTON_GESTURE_APPEND(BUTTON_GESTURE_CODE5(s1, s2, s3, s4, s5), s6)
+#define BUTTON_GESTURE_CODE7(s1, s2, s3, s4, s5, s6, s7) \
+		BUTTON_GESTURE_APPEND(BUTTON_GESTURE_CODE6(s1, s2, s3, s4, s5, s6), s7)
+#define BUTTON_GESTURE_CODE8(s1, s2, s3, s4, s5, s6, s7, s8) \
+		BUTTON_GESTURE_APPEND(BUTTON_GESTURE_CODE7(s1, s2, s3, s4, s5, s6, s7), s8)
+
+/* Typedefs ------------------------------------------------------------------*/
+
+/*!
+ * @struct
+ * @brief One registered gesture.
+ */
+typedef struct {
+	uint32_t code; /**< Gesture code (BUTTON_GESTURE_CODEn). */
+	uint8_t id; /**< Command id reported on a match. */
+} ButtonGesture_t;
+
+/* Exported Variables --------------------------------------------------------*/
+
+/* 1. Global Variables */
+
+/* Exported Functions (Inline) -----------------------------------------------*/
+
+/*!
+ * @fn     static inline uint32_t ButtonGesture_Append(uint32_t code, uint32_t symbol).
+ * @brief  Appends a symbol to a code built at run time.
+ * @param  code Gesture code, 0 once it overflowed.
+ * @param  symbol Gesture symbol.
+ * @return uint32_t New code, 0 when it no longer fits.
+ */
+static inline uint32_t ButtonGesture_Append(uint32_t code, uint32_t symbol) {
+	/* a full code has its leading bit at 2 * BUTTON_GESTURE_MAX_SYMBOLS */
+	if (code == 0U
+			|| code >= (1UL << (BUTTON_GESTURE_SYMBOL_BITS
+					* BUTTON_GESTURE_MAX_SYMBOLS))) {
+		return 0U;
+	}
+
+	return BUTTON_GESTURE_APPEND(code, symbol);
+}
+
+/* Exported Functions --------------------------------------------------------*/
+
+/* 1. Global Function Declarations */
+
+/*!
+ * @fn     return_t ButtonGesture_Match(const ButtonGesture_t *table, size_t count, uint32_t code, uint8_t *id).
+ * @brief  Looks a gesture code up in a table sorted by code.
+ * @param  table Gesture table, sorted by ascending code.
+ * @param  count Number of entries in the table.
+ * @param  code Gesture code (Button_GetGesture).
+ * @param  id Pointer to store the id of the matching entry.
+ * @return return_t Returns return_success, or return_failed when no entry matches.
+ */
+return_t ButtonGesture_Match(const ButtonGesture_t *table, size_t count,
+		uint32_t code, uint8_t *id);
+
+/*!
+ * @fn     bool ButtonGesture_IsSorted(const ButtonGesture_t *table, size_t count).
+ * @brief  Checks that a table is sorted by strictly ascending code.
+ * @param  table Gesture table.
+ * @param  count Number of entries in the table.
+ * @return bool true if ButtonGesture_Match can search the table.
+ * @note   Meant for a startup assert.
+ */
+bool ButtonGesture_IsSorted(const ButtonGesture_t *table, size_t count);
+
+#endif /* BUTTON_GESTURE_H */
+
+/* ******************** (C) COPYRIGHT [KeyhanSalehi] ******************* */
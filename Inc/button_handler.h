@@ -18,40 +18,525 @@
 /* Includes ------------------------------------------------------------------*/
 
 /* 1. System Header Files */
+#include <assert.h>
 #include <Common.h>
 /* 2. Project Header Files */
 #include "softTimer.h"
+#include "button_event.h"
 
 /* Defines & Macros ----------------------------------------------------------*/
 
-/*! @def @brief maximum push count. */
+/*! @def @brief default maximum push count (Button_SetMaxCount per button). */
+#ifndef PUSH_COUNT_MAX
 #define PUSH_COUNT_MAX 5
+#endif
+
+#if PUSH_COUNT_MAX < 1 || PUSH_COUNT_MAX > 254
+#error "PUSH_COUNT_MAX must be 1..254, push counts are 8-bit"
+#endif
+
+/*! @def @brief Define for deBounce delay (50ms).*/
+#ifndef DEBOUNCE_DELAY_MS
+#define DEBOUNCE_DELAY_MS 50
+#endif
+
+/*! @def @brief Define for timeout threshold (1 seconds).*/
+#ifndef BUTTON_TIMEOUT_MS
+#define BUTTON_TIMEOUT_MS SEC_TO_MS(1)
+#endif
+
+/*!
+ * @def   BUTTON_EARLY_RESOLVE
+ * @brief Close a sequence as soon as it reaches the button's max count (1)
+ *        instead of waiting for its timeout (0).
+ * @note  A button with a max count of 1 then reports right after its
+ *        debounced press. With BUTTON_GESTURE_ENABLE the sequence closes at
+ *        the release of that press instead, once its last symbol is known.
+ *        A press that comes before the closed sequence is read is held and
+ *        opens the next sequence at the poll after the read, so it does not
+ *        fail the closed one (further presses until the read are lost).
+ */
+#ifndef BUTTON_EARLY_RESOLVE
+#define BUTTON_EARLY_RESOLVE 0
+#endif
+
+/*! @def @brief policies for presses beyond the max count. */
+#define BUTTON_OVERFLOW_RESET 0 /**< The sequence fails (return_failed) and restarts. */
+#define BUTTON_OVERFLOW_SATURATE 1 /**< The count stays at the max count. */
+#define BUTTON_OVERFLOW_WRAP 2 /**< The count restarts at 1 within the sequence. */
+
+/*!
+ * @def   BUTTON_OVERFLOW_POLICY
+ * @brief What a press beyond the button's max count does to its sequence.
+ * @note  With SATURATE and WRAP a sequence never fails; the overflows are
+ *        still counted in the stats.
+ */
+#ifndef BUTTON_OVERFLOW_POLICY
+#define BUTTON_OVERFLOW_POLICY BUTTON_OVERFLOW_RESET
+#endif
+
+/*!
+ * @def   BUTTON_HOLD_ENABLE
+ * @brief Track held buttons for long-press and auto-repeat events (1), or
+ *        count clicks only (0).
+ * @note  A long press consumes the sequence it ends. While a button is held
+ *        its sequence stays open; it closes the timeout after the last release.
+ */
+#ifndef BUTTON_HOLD_ENABLE
+#define BUTTON_HOLD_ENABLE 0
+#endif
+
+/*! @def @brief Define for default long press time (800ms).*/
+#ifndef BUTTON_LONG_PRESS_MS
+#define BUTTON_LONG_PRESS_MS 800
+#endif
+
+/*! @def @brief Define for default auto-repeat period (200ms, 0 disables repeat).*/
+#ifndef BUTTON_REPEAT_MS
+#define BUTTON_REPEAT_MS 200
+#endif
+
+/*!
+ * @def   BUTTON_EXTI_ENABLE
+ * @brief Enable EXTI edge capture (1) or keep polling only (0).
+ * @note  When enabled, each Button_t carries a small edge queue filled by
+ *        Button_EXTI_Callback() from the EXTI interrupt.
+ */
+#ifndef BUTTON_EXTI_ENABLE
+#define BUTTON_EXTI_ENABLE 0
+#endif
+
+/*!
+ * @def   BUTTON_EXTI_QUEUE_SIZE
+ * @brief Number of edges buffered per button between two polls (power of 2).
+ * @note  A full queue folds further edges into its newest entry, so the
+ *        final pin level survives a long bounce burst.
+ */
+#ifndef BUTTON_EXTI_QUEUE_SIZE
+#define BUTTON_EXTI_QUEUE_SIZE 8
+#endif
+
+#if (BUTTON_EXTI_QUEUE_SIZE & (BUTTON_EXTI_QUEUE_SIZE - 1)) != 0 \
+		|| BUTTON_EXTI_QUEUE_SIZE < 4
+#error "BUTTON_EXTI_QUEUE_SIZE must be a power of 2 of at least 4"
+#endif
+
+/*!
+ * @def   BUTTON_TRACE_ENABLE
+ * @brief Let buttons record their raw pin edges into a ButtonTrace_t (1) or
+ *        not (0).
+ * @note  See button_trace.h. Adds one pointer to each Button_t.
+ */
+#ifndef BUTTON_TRACE_ENABLE
+#define BUTTON_TRACE_ENABLE 0
+#endif
+
+/*!
+ * @def   BUTTON_STATS_ENABLE
+ * @brief Keep per-button instrumentation counters (1) or compile them out (0).
+ * @note  Read them with Button_GetStats() to tune debounce values and to
+ *        check that the main loop polls often enough.
+ */
+#ifndef BUTTON_STATS_ENABLE
+#define BUTTON_STATS_ENABLE 0
+#endif
+
+/*!
+ * @def   BUTTON_ISR_SAFE
+ * @brief Let other contexts read results while the engine runs in an
+ *        interrupt, without critical sections (1), or not (0).
+ * @note  Every state field then has a single writer: the engine context
+ *        (Button_Process, the scan feeding Button_RegisterPress...) publishes
+ *        results, first presses and hold events with sequence counters in
+ *        one word each, and readers take them with Button_ReadResult,
+ *        Button_GetPress and Button_GetLongPress by comparing against their
+ *        own counters. Plain loads and stores only, so Cortex-M0 included.
+ */
+#ifndef BUTTON_ISR_SAFE
+#define BUTTON_ISR_SAFE 0
+#endif
+
+/*!
+ * @def   BUTTON_TIMER_WHEEL_ENABLE
+ * @brief Register sequence timeouts in a shared softTimerWheel_t (1) instead
+ *        of checking a per-button timer on every poll (0).
+ * @note  Set the wheel with Button_SetTimerWheel() before initializing the
+ *        buttons (asserted) and keep calling softTimerWheel_process() on it.
+ *        The timeout is only armed by a press, so idle buttons no longer
+ *        report an empty sequence every second. The timeout node takes 20
+ *        bytes instead of a 4-byte timer: every Button_t grows by 16 bytes
+ *        on a 32-bit MCU, the wheel saves time, not RAM.
+ */
+#ifndef BUTTON_TIMER_WHEEL_ENABLE
+#define BUTTON_TIMER_WHEEL_ENABLE 0
+#endif
+
+/*!
+ * @def   BUTTON_GESTURE_ENABLE
+ * @brief Record each sequence as short/long presses and pauses for
+ *        button_gesture.h (1), or count clicks only (0).
+ * @note  Read the gesture with Button_GetGesture after Button_GetFinalCount
+ *        succeeds. A gesture has at most as many presses as the max count.
+ */
+#ifndef BUTTON_GESTURE_ENABLE
+#define BUTTON_GESTURE_ENABLE 0
+#endif
+
+/*! @def @brief Define for the shortest long press of a gesture (300ms).*/
+#ifndef BUTTON_GESTURE_LONG_MS
+#define BUTTON_GESTURE_LONG_MS 300
+#endif
+
+/*! @def @brief Define for the shortest pause between two gesture presses (400ms).*/
+#ifndef BUTTON_GESTURE_PAUSE_MS
+#define BUTTON_GESTURE_PAUSE_MS 400
+#endif
+
+/*!
+ * @def   BUTTON_COMPACT_LAYOUT
+ * @brief Pack Button_t into 8 bytes (1) or keep the full layout (0).
+ * @note  The compact layout stores a port index and pin bit number instead of
+ *        the port pointer and pin mask, one flag byte, and 16-bit timestamps.
+ *        It supports polled and banked buttons.
+ */
+#ifndef BUTTON_COMPACT_LAYOUT
+#define BUTTON_COMPACT_LAYOUT 0
+#endif
+
+#if BUTTON_COMPACT_LAYOUT
+#if BUTTON_EXTI_ENABLE || BUTTON_TIMER_WHEEL_ENABLE
+#error "BUTTON_COMPACT_LAYOUT supports neither BUTTON_EXTI_ENABLE nor BUTTON_TIMER_WHEEL_ENABLE"
+#endif
+#if BUTTON_HOLD_ENABLE || BUTTON_TRACE_ENABLE || BUTTON_STATS_ENABLE
+#error "BUTTON_COMPACT_LAYOUT has no room for BUTTON_HOLD_ENABLE, BUTTON_TRACE_ENABLE or BUTTON_STATS_ENABLE"
+#endif
+#if BUTTON_GESTURE_ENABLE || BUTTON_ISR_SAFE
+#error "BUTTON_COMPACT_LAYOUT has no room for BUTTON_GESTURE_ENABLE or BUTTON_ISR_SAFE"
+#endif
+#if SOFTTIMER_TICKS_PER_MS != 1
+#error "BUTTON_COMPACT_LAYOUT keeps 16-bit timestamps, it needs a 1 ms tick"
+#endif
+/*! @def @brief address of the first GPIO port (port index 0). */
+#ifndef BUTTON_GPIO_BASE
+#define BUTTON_GPIO_BASE GPIOA_BASE
+#endif
+
+/*! @def @brief distance between two GPIO ports in the memory map. */
+#ifndef BUTTON_GPIO_STRIDE
+#define BUTTON_GPIO_STRIDE 0x400U
+#endif
+
+/*! @def @brief expected size of a compact Button_t. */
+#define BUTTON_COMPACT_SIZE 8U
+#endif /* BUTTON_COMPACT_LAYOUT */
+
+/*!
+ * @def   BUTTON_CONFIG_IN_FLASH
+ * @brief Keep each button's configuration in a const ButtonConfig_t that the
+ *        Button_t points to (1), or embed a copy in the Button_t (0).
+ * @note  With 1, buttons are set up with Button_InitConfig/Button_InitTable
+ *        from const tables (see button_table.h) and Button_Init is removed.
+ */
+#ifndef BUTTON_CONFIG_IN_FLASH
+#define BUTTON_CONFIG_IN_FLASH 0
+#endif
+
+#if BUTTON_COMPACT_LAYOUT && BUTTON_CONFIG_IN_FLASH
+#error "BUTTON_COMPACT_LAYOUT packs the configuration, it cannot use BUTTON_CONFIG_IN_FLASH"
+#endif
+
+/*!
+ * @def   BUTTON_FAST_READ
+ * @brief Read pins straight from the IDR register (1) or through
+ *        HAL_GPIO_ReadPin (0).
+ * @note  Removes a call, its assert and branches from every poll.
+ */
+#ifndef BUTTON_FAST_READ
+#define BUTTON_FAST_READ 0
+#endif
+
+/*!
+ * @def   BUTTON_READ_PIN
+ * @brief Reads one pin as a GPIO_PinState.
+ * @note  Define it before including this file to use LL drivers or a mock,
+ *        e.g. ((GPIO_PinState) LL_GPIO_IsInputPinSet(port, pin)).
+ */
+#ifndef BUTTON_READ_PIN
+#if BUTTON_FAST_READ
+#define BUTTON_READ_PIN(port, pin) \
+		((((port)->IDR & (pin)) != 0U) ? GPIO_PIN_SET : GPIO_PIN_RESET)
+#else
+#define BUTTON_READ_PIN(port, pin) HAL_GPIO_ReadPin((port), (pin))
+#endif
+#endif
+
+/*!
+ * @def   BUTTON_READ_PORT
+ * @brief Reads all pins of a port at once (used by ButtonBank_Scan).
+ * @note  Define it before including this file to use LL drivers or a mock.
+ */
+#ifndef BUTTON_READ_PORT
+#define BUTTON_READ_PORT(port) ((uint16_t) (port)->IDR)
+#endif
+
+/*! @def @brief pin state of a pressed button, resolved from the pull configuration. */
+#define BUTTON_ACTIVE_STATE_OF(pull) \
+		(((pull) == GPIO_PULLUP) ? GPIO_PIN_RESET : GPIO_PIN_SET)
+
+#if BUTTON_HOLD_ENABLE
+/*!
+ * @def   BUTTON_CONFIG_INIT_HOLD
+ * @brief Constant initializer of a ButtonConfig_t with its hold timing.
+ */
+#define BUTTON_CONFIG_INIT_HOLD(port, pin, pull, debounceMs, timeoutMs, maxCount, \
+		longPressMs, repeatMs) \
+		{ (port), (pin), (uint8_t) BUTTON_ACTIVE_STATE_OF(pull), (maxCount), \
+		  SOFTTIMER_MS_TO_TICKS(debounceMs), (timeoutMs), (longPressMs), (repeatMs) }
+
+/*!
+ * @def   BUTTON_CONFIG_INIT
+ * @brief Constant initializer of a ButtonConfig_t (default hold timing).
+ */
+#define BUTTON_CONFIG_INIT(port, pin, pull, debounceMs, timeoutMs, maxCount) \
+		BUTTON_CONFIG_INIT_HOLD(port, pin, pull, debounceMs, timeoutMs, maxCount, \
+				BUTTON_LONG_PRESS_MS, BUTTON_REPEAT_MS)
+#else
+/*!
+ * @def   BUTTON_CONFIG_INIT
+ * @brief Constant initializer of a ButtonConfig_t.
+ */
+#define BUTTON_CONFIG_INIT(port, pin, pull, debounceMs, timeoutMs, maxCount) \
+		{ (port), (pin), (uint8_t) BUTTON_ACTIVE_STATE_OF(pull), (maxCount), \
+		  SOFTTIMER_MS_TO_TICKS(debounceMs), (timeoutMs) }
+#endif /* BUTTON_HOLD_ENABLE */
+
+/*!
+ * @brief Accessors that work with every Button_t layout.
+ * @note  Timing accessors return ticks (SOFTTIMER_TICKS_PER_MS per ms).
+ */
+#if BUTTON_COMPACT_LAYOUT
+#define BUTTON_PORT(button) ((GPIO_TypeDef *) (BUTTON_GPIO_BASE \
+		+ (uintptr_t) (button)->portIndex * BUTTON_GPIO_STRIDE))
+#define BUTTON_PIN(button) ((uint16_t) (1U << (button)->pinBit))
+#define BUTTON_ACTIVE_STATE(button) ((GPIO_PinState) (button)->activeState)
+#define BUTTON_DEBOUNCE(button) ((uint32_t) DEBOUNCE_DELAY_MS)
+#define BUTTON_TIMEOUT(button) ((uint32_t) BUTTON_TIMEOUT_MS)
+#define BUTTON_MAX_COUNT(button) ((uint8_t) PUSH_COUNT_MAX)
+#else
+#if BUTTON_CONFIG_IN_FLASH
+#define BUTTON_CONFIG(button) ((button)->config)
+#else
+#define BUTTON_CONFIG(button) (&(button)->config)
+#endif
+#define BUTTON_PORT(button) (BUTTON_CONFIG(button)->port)
+#define BUTTON_PIN(button) (BUTTON_CONFIG(button)->pin)
+#define BUTTON_ACTIVE_STATE(button) ((GPIO_PinState) BUTTON_CONFIG(button)->activeState)
+#define BUTTON_DEBOUNCE(button) ((uint32_t) BUTTON_CONFIG(button)->debounceTime)
+#define BUTTON_TIMEOUT(button) SOFTTIMER_MS_TO_TICKS(BUTTON_CONFIG(button)->timeoutTime)
+#define BUTTON_MAX_COUNT(button) (BUTTON_CONFIG(button)->maxCount)
+#if BUTTON_HOLD_ENABLE
+#define BUTTON_LONG_PRESS(button) SOFTTIMER_MS_TO_TICKS(BUTTON_CONFIG(button)->longPressTime)
+#define BUTTON_REPEAT(button) SOFTTIMER_MS_TO_TICKS(BUTTON_CONFIG(button)->repeatTime)
+#endif
+#endif
+#define BUTTON_IS_ACTIVE_LOW(button) (BUTTON_ACTIVE_STATE(button) == GPIO_PIN_RESET)
 
 /* Typedefs ------------------------------------------------------------------*/
 
+#if BUTTON_TRACE_ENABLE
+typedef struct ButtonTrace ButtonTrace_t; /**< Edge recorder, see button_trace.h. */
+#endif
+
+/*!
+ * @enum
+ * @brief State of a button's push sequence (Button_GetState).
+ */
+typedef enum {
+	BUTTON_STATE_IDLE, /**< No sequence, no timeout armed. */
+	BUTTON_STATE_COUNTING, /**< Presses counted, timeout armed by the first press. */
+	BUTTON_STATE_RESOLVED, /**< Sequence closed, result waiting for Button_GetFinalCount. */
+} ButtonState_t;
+
+/*!
+ * @enum
+ * @brief Where a button gets its pin transitions from.
+ */
+typedef enum {
+	BUTTON_SOURCE_POLL, /**< Pin is read on every Button_GetFinalCount call. */
+	BUTTON_SOURCE_EXTI, /**< Edges are timestamped by the EXTI interrupt. */
+	BUTTON_SOURCE_EXTERNAL, /**< Debounced presses are fed by Button_RegisterPress (e.g. ButtonBank_t). */
+} ButtonSource_t;
+
 /*!
  * @struct
- * @brief Structure to hold button configuration and state.
+ * @brief Immutable configuration of a button.
+ * @note  Build it with BUTTON_CONFIG_INIT so the active level is resolved
+ *        at compile time.
  */
 typedef struct {
 	GPIO_TypeDef *port; /**< GPIO port (e.g., GPIOA). */
 	uint16_t pin; /**< GPIO pin number (e.g., GPIO_PIN_0). */
+	uint8_t activeState; /**< Pin state of a press (GPIO_PinState). */
+	uint8_t maxCount; /**< Highest valid push count. */
+	uint16_t debounceTime; /**< Minimum time between two presses in ticks. */
+	uint16_t timeoutTime; /**< Idle time closing a sequence in ms. */
+#if BUTTON_HOLD_ENABLE
+	uint16_t longPressTime; /**< Hold time reported as a long press in ms (0 disables). */
+	uint16_t repeatTime; /**< Auto-repeat period after a long press in ms (0 disables). */
+#endif
+} ButtonConfig_t;
+
+#if !BUTTON_COMPACT_LAYOUT
+static_assert(SOFTTIMER_MS_TO_TICKS(DEBOUNCE_DELAY_MS) <= UINT16_MAX,
+		"the debounce time is kept in 16-bit ticks, lower DEBOUNCE_DELAY_MS");
+#endif
+
+#if BUTTON_STATS_ENABLE
+/*!
+ * @struct
+ * @brief Instrumentation counters of a button.
+ * @note  Counters saturate at UINT16_MAX.
+ */
+typedef struct {
+	uint16_t accepted; /**< Presses accepted by the debounce. */
+	uint16_t bounceRejected; /**< Press edges inside the debounce window. */
+	uint16_t overflows; /**< Sequences failed for exceeding the max count. */
+	uint16_t timeouts; /**< Sequences with presses closed by their timeout. */
+	uint16_t droppedEdges; /**< EXTI edges folded into the newest of a full edge queue. */
+	uint16_t maxPollInterval; /**< Longest time between two polls in ticks. */
+	uint32_t lastPoll; /**< Tick of the previous poll. */
+} ButtonStats_t;
+#endif /* BUTTON_STATS_ENABLE */
+
+/*!
+ * @struct
+ * @brief One closed sequence reported by Button_ProcessAll.
+ */
+typedef struct {
+	uint16_t index; /**< Index of the button in the array. */
+	uint8_t id; /**< Id of the button (Button_SetId). */
+	uint8_t count; /**< Push count of the sequence. */
+} ButtonResult_t;
+
+#if BUTTON_COMPACT_LAYOUT
+/*!
+ * @struct
+ * @brief Structure to hold button configuration and state (8 bytes).
+ */
+typedef struct {
+	uint8_t portIndex :4; /**< GPIO port index (0 for GPIOA, 1 for GPIOB...). */
+	uint8_t pinBit :4; /**< GPIO pin bit number (0 for GPIO_PIN_0...). */
+	uint8_t activeState :1; /**< Pin state of a press (GPIO_PinState). */
+	uint8_t lastState :1; /**< Last recorded button state. */
+	uint8_t isReadFinish :1; /**< Flag indicating read completion. */
+	uint8_t isPressPending :1; /**< First press not yet read by Button_GetPress. */
+	uint8_t isPressHeld :1; /**< Press held for the next sequence until this one is read. */
+	uint8_t source :2; /**< Transition source (ButtonSource_t). */
+	volatile uint8_t pushCount; /**< Number of button pushes. */
+	uint8_t id; /**< Id reported in button events. */
+	softTimer16_t debounceTimer; /**< Low 16 bits of the debounce start tick. */
+	softTimer16_t timeoutTimer; /**< Low 16 bits of the timeout start tick. */
+} Button_t;
+
+static_assert(sizeof(Button_t) == BUTTON_COMPACT_SIZE,
+		"compact Button_t grew, check its fields");
+static_assert((DEBOUNCE_DELAY_MS < 0x8000) && (BUTTON_TIMEOUT_MS < 0x8000),
+		"compact Button_t timestamps are 16-bit, keep delays below 32768 ms");
+#else
+/*!
+ * @struct
+ * @brief Structure to hold button configuration and state.
+ */
+typedef struct {
+#if BUTTON_CONFIG_IN_FLASH
+	const ButtonConfig_t *config; /**< Configuration, usually in a const table. */
+#else
+	ButtonConfig_t config; /**< Configuration. */
+#endif
 	volatile uint8_t pushCount; /**< Number of button pushes. */
 	volatile bool isReadFinish; /**< Flag indicating read completion. */
+	volatile bool isPressPending; /**< First press not yet read by Button_GetPress. */
+	bool isPressHeld; /**< Press held for the next sequence until this one is read. */
 	softTimer_t debounceTimer; /**< Software timer for debounCing. */
+#if BUTTON_TIMER_WHEEL_ENABLE
+	softTimerNode_t timeoutNode; /**< Sequence timeout registered in the wheel. */
+#else
 	softTimer_t timeoutTimer; /**< Software timer for timeout. */
+#endif
 	GPIO_PinState lastState; /**< Last recorded button state. */
-	uint32_t pull; /**< Pull configuration (GPIO_PULLUP, GPIO_PULLDOWN, or GPIO_NOPULL). */
+	uint8_t source; /**< Transition source (ButtonSource_t). */
+	uint8_t id; /**< Id reported in button events. */
+	uint16_t pressDuration; /**< Duration of the last press in ms. */
+#if BUTTON_HOLD_ENABLE
+	bool isHeld; /**< Accepted press not released yet. */
+	volatile bool isHoldPending; /**< Hold event not yet read by Button_GetLongPress. */
+	uint8_t holdCount; /**< Hold events of the current press (1 = long press). */
+	softTimer_t holdTimer; /**< Tick of the press or of the last hold event. */
+#endif
+#if BUTTON_TRACE_ENABLE
+	ButtonTrace_t *trace; /**< Recorder of the raw pin edges, or NULL. */
+#endif
+#if BUTTON_STATS_ENABLE
+	ButtonStats_t stats; /**< Instrumentation counters. */
+#endif
+#if BUTTON_GESTURE_ENABLE
+	uint32_t gesture; /**< Symbols of the current or last sequence (button_gesture.h). */
+	uint32_t releaseTick; /**< Tick of the last release, start of a pause. */
+#endif
+#if BUTTON_ISR_SAFE
+	volatile uint32_t published; /**< Result count (bits 0-7, 0 = overflow) and sequence (8-15), press sequence (16-23), engine-written. */
+	uint8_t resultTaken; /**< Result sequence last read, reader-written. */
+	uint8_t pressTaken; /**< Press sequence last read, reader-written. */
+#if BUTTON_HOLD_ENABLE
+	volatile uint16_t holdPublished; /**< Repeat number (bits 0-7) and hold sequence (8-15), engine-written. */
+	uint8_t holdTaken; /**< Hold sequence last read, reader-written. */
+#endif
+#endif
+#if BUTTON_EXTI_ENABLE
+	volatile uint32_t edgeTick[BUTTON_EXTI_QUEUE_SIZE]; /**< Tick of each queued edge. */
+	volatile uint8_t edgeState[BUTTON_EXTI_QUEUE_SIZE]; /**< Pin state after each queued edge. */
+	volatile uint8_t edgeHead; /**< Write index, owned by the EXTI interrupt. */
+	volatile uint8_t edgeTail; /**< Read index, owned by Button_GetFinalCount. */
+#endif
 } Button_t;
+#endif /* BUTTON_COMPACT_LAYOUT */
 
 /* Exported Variables --------------------------------------------------------*/
 
 /* 1. Global Variables */
 
+/* Exported Functions (Inline) -----------------------------------------------*/
+
+/*!
+ * @fn     static inline GPIO_PinState Button_ReadRaw(const Button_t *button).
+ * @brief  Reads the raw (not debounced) pin state of a button.
+ * @param  button Pointer to the Button_t structure.
+ * @return GPIO_PinState Pin state read through BUTTON_READ_PIN.
+ */
+static inline GPIO_PinState Button_ReadRaw(const Button_t *button) {
+	return BUTTON_READ_PIN(BUTTON_PORT(button), BUTTON_PIN(button));
+}
+
+/*!
+ * @fn     static inline ButtonState_t Button_GetState(const Button_t *button).
+ * @brief  Gets the state of a button's push sequence.
+ * @param  button Pointer to the Button_t structure.
+ * @return ButtonState_t Derived from the push count and the read flag, so
+ *         every layout keeps its size.
+ */
+static inline ButtonState_t Button_GetState(const Button_t *button) {
+	if (button->isReadFinish) {
+		return BUTTON_STATE_RESOLVED;
+	}
+
+	return (button->pushCount > 0U) ? BUTTON_STATE_COUNTING : BUTTON_STATE_IDLE;
+}
+
 /* Exported Functions --------------------------------------------------------*/
 
 /* 1. Global Function Declarations */
 
+#if !BUTTON_CONFIG_IN_FLASH
 /*!
  * @fn     void Button_Init(Button_t *button, GPIO_TypeDef *port, uint16_t pin).
  * @brief  Initializes a button with specified port and pin.
@@ -63,6 +548,30 @@ typedef struct {
  */
 void Button_Init(Button_t *button, GPIO_TypeDef *port, uint16_t pin,
 		uint32_t pull);
+#endif /* !BUTTON_CONFIG_IN_FLASH */
+
+/*!
+ * @fn     void Button_InitConfig(Button_t *button, const ButtonConfig_t *config).
+ * @brief  Initializes a button from a configuration.
+ * @param  button Pointer to the Button_t structure.
+ * @param  config Pointer to the configuration; with BUTTON_CONFIG_IN_FLASH it
+ *         must outlive the button (e.g. a const table).
+ * @return void
+ * @note   The compact layout keeps port, pin and active level only.
+ */
+void Button_InitConfig(Button_t *button, const ButtonConfig_t *config);
+
+/*!
+ * @fn     void Button_InitTable(Button_t *buttons, const ButtonConfig_t *configs, size_t count).
+ * @brief  Initializes an array of buttons from an array of configurations.
+ * @param  buttons Array of buttons.
+ * @param  configs Array of configurations, one per button.
+ * @param  count Number of buttons.
+ * @return void
+ * @note   Each button gets its array index as id.
+ */
+void Button_InitTable(Button_t *buttons, const ButtonConfig_t *configs,
+		size_t count);
 
 /*!
  * @fn     return_t Button_GetFinalCount(Button_t *button, uint8_t *finalCount).
@@ -73,6 +582,343 @@ void Button_Init(Button_t *button, GPIO_TypeDef *port, uint16_t pin,
  */
 return_t Button_GetFinalCount(Button_t *button, uint8_t *finalCount);
 
+/*!
+ * @fn     return_t Button_GetFinalCountAt(Button_t *button, uint8_t *finalCount, uint32_t now).
+ * @brief  Same as Button_GetFinalCount, with the tick snapshot of the pass.
+ * @param  button Pointer to the Button_t structure.
+ * @param  finalCount Pointer to store the final push count.
+ * @param  now Tick read once for the whole pass (SOFTTIMER_TICK()).
+ * @return return_t Returns return_success, return_failed, or return_busy.
+ * @note   Polling many buttons with one snapshot saves a tick read per
+ *         button and keeps them all on the same time base.
+ */
+return_t Button_GetFinalCountAt(Button_t *button, uint8_t *finalCount,
+		uint32_t now);
+
+#if BUTTON_ISR_SAFE
+/*!
+ * @fn     return_t Button_ReadResult(Button_t *button, uint8_t *finalCount).
+ * @brief  Takes the latest result published by the engine, from any context.
+ * @param  button Pointer to the Button_t structure.
+ * @param  finalCount Pointer to store the final push count.
+ * @return return_t Returns return_success, return_failed (overflow), or
+ *         return_busy when no new result was published.
+ * @note   Reader side: never writes the engine's fields, so the engine may
+ *         run Button_Process or Button_GetFinalCount in an interrupt meanwhile.
+ *         Results published between two calls are merged into the latest one;
+ *         use the event queue to keep them all.
+ */
+return_t Button_ReadResult(Button_t *button, uint8_t *finalCount);
+#endif
+
+/*!
+ * @fn     return_t Button_GetPress(Button_t *button).
+ * @brief  Reports the first debounced press of a sequence right away.
+ * @param  button Pointer to the Button_t structure.
+ * @return return_t Returns return_success once per sequence, as soon as its
+ *         first press was detected, or return_busy.
+ * @note   Does not sample the button: call it after Button_GetFinalCount
+ *         (or the scan feeding the button). The push count of the sequence
+ *         is still reported by Button_GetFinalCount when it closes.
+ */
+return_t Button_GetPress(Button_t *button);
+
+#if BUTTON_HOLD_ENABLE
+/*!
+ * @fn     return_t Button_GetLongPress(Button_t *button, uint8_t *repeatCount).
+ * @brief  Reports long-press and auto-repeat events of a held button.
+ * @param  button Pointer to the Button_t structure.
+ * @param  repeatCount Pointer to store 0 for the long press, then the repeat number.
+ * @return return_t Returns return_success once per hold event, or return_busy.
+ * @note   Does not sample the button: call it after Button_GetFinalCount.
+ *         Events missed between two calls are merged into the latest one.
+ */
+return_t Button_GetLongPress(Button_t *button, uint8_t *repeatCount);
+
+/*!
+ * @fn     uint32_t Button_GetPressDuration(const Button_t *button, uint32_t now).
+ * @brief  Gets how long the button is held, or how long its last press lasted.
+ * @param  button Pointer to the Button_t structure.
+ * @param  now Current tick (SOFTTIMER_TICK()).
+ * @return uint32_t Duration in ms.
+ */
+uint32_t Button_GetPressDuration(const Button_t *button, uint32_t now);
+#endif /* BUTTON_HOLD_ENABLE */
+
+#if !BUTTON_CONFIG_IN_FLASH && !BUTTON_COMPACT_LAYOUT
+/*!
+ * @fn     void Button_SetTiming(Button_t *button, uint16_t debounceMs, uint16_t timeoutMs).
+ * @brief  Changes the debounce delay and sequence timeout of a button.
+ * @param  button Pointer to the Button_t structure.
+ * @param  debounceMs Minimum time between two presses in ms, saturated
+ *         at UINT16_MAX ticks.
+ * @param  timeoutMs Idle time closing a sequence in ms.
+ * @return void
+ * @note   Takes effect from the next press.
+ */
+void Button_SetTiming(Button_t *button, uint16_t debounceMs, uint16_t timeoutMs);
+
+/*!
+ * @fn     void Button_SetDebounceTicks(Button_t *button, uint16_t debounceTicks).
+ * @brief  Changes the debounce delay of a button in ticks.
+ * @param  button Pointer to the Button_t structure.
+ * @param  debounceTicks Minimum time between two presses in ticks.
+ * @return void
+ * @note   Gives sub-ms debounce with a fast tick (1 us at
+ *         SOFTTIMER_TICKS_PER_MS 1000, up to 65.5 ms).
+ */
+void Button_SetDebounceTicks(Button_t *button, uint16_t debounceTicks);
+
+/*!
+ * @fn     void Button_SetMaxCount(Button_t *button, uint8_t maxCount).
+ * @brief  Changes the highest valid push count of a button.
+ * @param  button Pointer to the Button_t structure.
+ * @param  maxCount Highest valid push count.
+ * @return void
+ */
+void Button_SetMaxCount(Button_t *button, uint8_t maxCount);
+
+#if BUTTON_HOLD_ENABLE
+/*!
+ * @fn     void Button_SetHoldTiming(Button_t *button, uint16_t longPressMs, uint16_t repeatMs).
+ * @brief  Changes the long press time and auto-repeat period of a button.
+ * @param  button Pointer to the Button_t structure.
+ * @param  longPressMs Hold time reported as a long press in ms (0 disables).
+ * @param  repeatMs Auto-repeat period after the long press in ms (0 disables).
+ * @return void
+ * @note   Takes effect from the next press.
+ */
+void Button_SetHoldTiming(Button_t *button, uint16_t longPressMs,
+		uint16_t repeatMs);
+#endif
+#endif /* !BUTTON_CONFIG_IN_FLASH && !BUTTON_COMPACT_LAYOUT */
+
+/*!
+ * @fn     void Button_RegisterPress(Button_t *button, uint32_t tick).
+ * @brief  Counts one already debounced press of the button.
+ * @param  button Pointer to the Button_t structure.
+ * @param  tick Tick at which the press was detected.
+ * @return void
+ * @note   Used by scanners that debounce several pins at once (ButtonBank_t).
+ */
+void Button_RegisterPress(Button_t *button, uint32_t tick);
+
+/*!
+ * @fn     bool Button_CountPress(Button_t *button, uint32_t tick).
+ * @brief  Counts one already debounced press without reporting it.
+ * @param  button Pointer to the Button_t structure.
+ * @param  tick Tick at which the press was detected.
+ * @return bool true if the press started a sequence, whose first press is
+ *         then reported by Button_ReportPress.
+ * @note   Lets a chord detector hold back the first press of its members.
+ */
+bool Button_CountPress(Button_t *button, uint32_t tick);
+
+/*!
+ * @fn     void Button_ReportPress(Button_t *button, uint32_t tick).
+ * @brief  Reports the first press of a sequence (Button_GetPress, BUTTON_EVENT_PRESS).
+ * @param  button Pointer to the Button_t structure.
+ * @param  tick Tick of the event.
+ * @return void
+ */
+void Button_ReportPress(Button_t *button, uint32_t tick);
+
+/*!
+ * @fn     void Button_RegisterRelease(Button_t *button, uint32_t tick).
+ * @brief  Records the release of a press fed by Button_RegisterPress.
+ * @param  button Pointer to the Button_t structure.
+ * @param  tick Tick at which the release was detected.
+ * @return void
+ */
+void Button_RegisterRelease(Button_t *button, uint32_t tick);
+
+/*!
+ * @fn     void Button_Cancel(Button_t *button).
+ * @brief  Drops the sequence in progress without reporting it.
+ * @param  button Pointer to the Button_t structure.
+ * @return void
+ * @note   Used when the presses were claimed by something else (e.g. a chord
+ *         of button_chord.h). A held button raises no hold events either.
+ */
+void Button_Cancel(Button_t *button);
+
+/*!
+ * @fn     void Button_SetId(Button_t *button, uint8_t id).
+ * @brief  Sets the id the button reports in its events.
+ * @param  button Pointer to the Button_t structure.
+ * @param  id Button id.
+ * @return void
+ */
+void Button_SetId(Button_t *button, uint8_t id);
+
+/*!
+ * @fn     void Button_SetEventQueue(ButtonEventQueue_t *queue).
+ * @brief  Sets the queue Button_Process publishes events to.
+ * @param  queue Pointer to an initialized ButtonEventQueue_t, or NULL.
+ * @return void
+ */
+void Button_SetEventQueue(ButtonEventQueue_t *queue);
+
+/*!
+ * @fn     ButtonEventQueue_t* Button_GetEventQueue(void).
+ * @brief  Gets the queue set by Button_SetEventQueue.
+ * @return ButtonEventQueue_t* Event queue, or NULL when none is set.
+ * @note   Lets other input drivers (e.g. button_encoder.h) share the queue.
+ */
+ButtonEventQueue_t* Button_GetEventQueue(void);
+
+/*!
+ * @fn     void Button_Process(Button_t *button).
+ * @brief  Runs the button engine and publishes closed sequences as events.
+ * @param  button Pointer to the Button_t structure.
+ * @return void
+ * @note   Producer side of the event queue: call it from one context only
+ *         (e.g. SysTick), instead of Button_GetFinalCount. The first press of
+ *         a sequence is published at once as BUTTON_EVENT_PRESS, and with
+ *         BUTTON_HOLD_ENABLE a held button publishes BUTTON_EVENT_LONG_PRESS
+ *         then BUTTON_EVENT_REPEAT. Scanners feeding Button_RegisterPress
+ *         must run in the same context.
+ */
+void Button_Process(Button_t *button);
+
+/*!
+ * @fn     void Button_ProcessAt(Button_t *button, uint32_t now).
+ * @brief  Same as Button_Process, with the tick snapshot of the pass.
+ * @param  button Pointer to the Button_t structure.
+ * @param  now Tick read once for the whole pass (SOFTTIMER_TICK()).
+ * @return void
+ */
+void Button_ProcessAt(Button_t *button, uint32_t now);
+
+/*!
+ * @fn     size_t Button_ProcessAll(Button_t *buttons, size_t count, ButtonResult_t *results).
+ * @brief  Runs Button_Process over an array with one tick snapshot.
+ * @param  buttons Array of buttons.
+ * @param  count Number of buttons in the array (at most UINT16_MAX).
+ * @param  results Array of count entries to store the closed sequences.
+ * @return size_t Number of results stored, in array order.
+ * @note   Closed sequences are also published like Button_Process does.
+ */
+size_t Button_ProcessAll(Button_t *buttons, size_t count,
+		ButtonResult_t *results);
+
+#if BUTTON_GESTURE_ENABLE
+/*!
+ * @fn     uint32_t Button_GetGesture(const Button_t *button).
+ * @brief  Gets the gesture code of the last closed sequence.
+ * @param  button Pointer to the Button_t structure.
+ * @return uint32_t Gesture code (button_gesture.h), 0 when the sequence had
+ *         more symbols than a code holds.
+ * @note   Valid after Button_GetFinalCount returns return_success, until the
+ *         next press.
+ */
+uint32_t Button_GetGesture(const Button_t *button);
+#endif
+
+#if BUTTON_STATS_ENABLE
+/*!
+ * @fn     void Button_GetStats(const Button_t *button, ButtonStats_t *stats).
+ * @brief  Copies the instrumentation counters of a button.
+ * @param  button Pointer to the Button_t structure.
+ * @param  stats Pointer to store the counters.
+ * @return void
+ */
+void Button_GetStats(const Button_t *button, ButtonStats_t *stats);
+
+/*!
+ * @fn     void Button_ResetStats(Button_t *button).
+ * @brief  Clears the instrumentation counters of a button.
+ * @param  button Pointer to the Button_t structure.
+ * @return void
+ * @note   The poll interval is measured again from this call.
+ */
+void Button_ResetStats(Button_t *button);
+#endif /* BUTTON_STATS_ENABLE */
+
+/*!
+ * @fn     bool Button_NextDeadline(const Button_t *buttons, size_t count, uint32_t now, uint32_t *deadline).
+ * @brief  Finds the earliest tick at which any of the buttons needs a poll.
+ * @param  buttons Array of buttons.
+ * @param  count Number of buttons in the array.
+ * @param  now Current tick (SOFTTIMER_TICK()).
+ * @param  deadline Pointer to store the earliest deadline tick.
+ * @return bool true if a deadline is pending, false if the buttons can sleep
+ *         until the next edge.
+ * @note   Idle buttons (no press counted) have no deadline: sleeping over
+ *         their empty timeout only merges those return_failed reports.
+ *         Polled buttons still need their pin sampled, so only sleep on
+ *         EXTI or banked buttons.
+ */
+bool Button_NextDeadline(const Button_t *buttons, size_t count, uint32_t now,
+		uint32_t *deadline);
+
+#if BUTTON_TIMER_WHEEL_ENABLE
+/*!
+ * @fn     void Button_SetTimerWheel(softTimerWheel_t *wheel).
+ * @brief  Sets the wheel all buttons register their timeouts with.
+ * @param  wheel Pointer to an initialized softTimerWheel_t.
+ * @return void
+ * @note   Call it before initializing the buttons.
+ */
+void Button_SetTimerWheel(softTimerWheel_t *wheel);
+
+/*!
+ * @fn     softTimerWheel_t* Button_GetTimerWheel(void).
+ * @brief  Gets the wheel the buttons register their timeouts with.
+ * @return softTimerWheel_t* Wheel set by Button_SetTimerWheel, or NULL.
+ */
+softTimerWheel_t* Button_GetTimerWheel(void);
+#endif /* BUTTON_TIMER_WHEEL_ENABLE */
+
+#if BUTTON_EXTI_ENABLE
+#if !BUTTON_CONFIG_IN_FLASH
+/*!
+ * @fn     void Button_InitEXTI(Button_t *button, GPIO_TypeDef *port, uint16_t pin, uint32_t pull).
+ * @brief  Initializes a button whose edges are captured by the EXTI interrupt.
+ * @param  button Pointer to the Button_t structure.
+ * @param  port GPIO port.
+ * @param  pin GPIO pin.
+ * @param  pull Pull configuration (GPIO_PULLUP, GPIO_PULLDOWN, or GPIO_NOPULL).
+ * @return void
+ * @note   Configure the pin as GPIO_MODE_IT_RISING_FALLING in CubeMx.
+ */
+void Button_InitEXTI(Button_t *button, GPIO_TypeDef *port, uint16_t pin,
+		uint32_t pull);
+#endif /* !BUTTON_CONFIG_IN_FLASH */
+
+/*!
+ * @fn     void Button_EnableEXTI(Button_t *button).
+ * @brief  Switches an initialized button to EXTI edge capture.
+ * @param  button Pointer to the Button_t structure.
+ * @return void
+ * @note   Configure the pin as GPIO_MODE_IT_RISING_FALLING in CubeMx.
+ */
+void Button_EnableEXTI(Button_t *button);
+
+/*!
+ * @fn     void Button_EXTI_Callback(Button_t *button).
+ * @brief  Timestamps a pin transition of the button, call from the EXTI ISR.
+ * @param  button Pointer to the Button_t structure.
+ * @return void
+ * @note   Call it from HAL_GPIO_EXTI_Callback() when GPIO_Pin == BUTTON_PIN(button).
+ *         Edges arriving while the queue is full are dropped.
+ */
+void Button_EXTI_Callback(Button_t *button);
+
+/*!
+ * @fn     void Button_QueueEdge(Button_t *button, uint32_t tick, GPIO_PinState state).
+ * @brief  Queues a pin transition timestamped by the caller.
+ * @param  button Pointer to the Button_t structure.
+ * @param  tick Tick of the transition (SOFTTIMER_TICK() time base).
+ * @param  state Pin state after the transition.
+ * @return void
+ * @note   Producer side of the edge queue, for edge sources with their own
+ *         timestamps (e.g. button_capture.h). Same context rules as
+ *         Button_EXTI_Callback.
+ */
+void Button_QueueEdge(Button_t *button, uint32_t tick, GPIO_PinState state);
+#endif /* BUTTON_EXTI_ENABLE */
+
 #endif /* BUTTON_HANDLER_H */
 
 /* ******************** (C) COPYRIGHT [KeyhanSalehi] ******************* */
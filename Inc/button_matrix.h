@@ -0,0 +1,143 @@
+/*!
+ *******************************************************************************
+ * @file           : button_matrix.h
+ * @author         : KeyhanSalehi
+ * @brief          : Header file for the Button Matrix (keypad) scanner.
+ *******************************************************************************
+ * @attention
+ *
+ * Drives the rows of a key matrix one at a time and reads all columns with
+ * one IDR access per row. Every key is one lane of a 32-lane vertical
+ * counter and a regular Button_t, so keys count clicks and publish events
+ * like any other button.
+ *
+ *******************************************************************************
+ */
+
+#ifndef BUTTON_MATRIX_H
+#define BUTTON_MATRIX_H
+
+/* Includes ------------------------------------------------------------------*/
+
+/* 1. System Header Files */
+#include <Common.h>
+/* 2. Project Header Files */
+#include "button_handler.h"
+#include "button_vcounter.h"
+
+/* Defines & Macros ----------------------------------------------------------*/
+
+/*! @def @brief maximum number of keys of a matrix (vertical counter lanes). */
+#define BUTTON_MATRIX_MAX_KEYS 32
+
+/*! @def @brief sample period of the matrix scan. */
+#ifndef BUTTON_MATRIX_SAMPLE_MS
+#define BUTTON_MATRIX_SAMPLE_MS (DEBOUNCE_DELAY_MS / BUTTON_VCOUNTER_SAMPLES)
+#endif
+
+/*!
+ * @def   BUTTON_MATRIX_DRIVE
+ * @brief Sets and resets row pins with one port write.
+ * @note  Define it before including this file to use LL drivers or a mock.
+ */
+#ifndef BUTTON_MATRIX_DRIVE
+#if defined(HOST_SIM) && HOST_SIM
+#define BUTTON_MATRIX_DRIVE(port, setMask, resetMask) \
+		((port)->ODR = ((port)->ODR | (setMask)) & ~(uint32_t) (resetMask))
+#else
+#define BUTTON_MATRIX_DRIVE(port, setMask, resetMask) \
+		((port)->BSRR = ((uint32_t) (resetMask) << 16) | (setMask))
+#endif
+#endif
+
+/*!
+ * @def   BUTTON_MATRIX_SETTLE
+ * @brief Delay between driving a row and reading the columns.
+ * @note  Long wires or weak pull-ups need a longer delay.
+ */
+#ifndef BUTTON_MATRIX_SETTLE
+#define BUTTON_MATRIX_SETTLE() do { __NOP(); __NOP(); __NOP(); __NOP(); } while (0)
+#endif
+
+/* Typedefs ------------------------------------------------------------------*/
+
+/*!
+ * @struct
+ * @brief Scan state of one key matrix.
+ * @note  Rows are outputs driven low one at a time (open-drain or push-pull),
+ *        columns are consecutive pull-up inputs of one port.
+ */
+typedef struct {
+	GPIO_TypeDef *rowPort; /**< GPIO port of the row pins. */
+	uint16_t rowMask; /**< Row pins, the lowest pin is row 0. */
+	GPIO_TypeDef *colPort; /**< GPIO port of the column pins. */
+	uint8_t colShift; /**< Pin number of column 0. */
+	uint8_t colCount; /**< Number of columns. */
+	uint32_t keyMask; /**< Lanes with a key attached. */
+	ButtonVCounter_t vcounter; /**< Lane counters, state is the debounced pressed mask. */
+	softTimer_t sampleTimer; /**< Paces the scans. */
+	Button_t *buttons[BUTTON_MATRIX_MAX_KEYS]; /**< Button of each lane (row * colCount + column). */
+} ButtonMatrix_t;
+
+/* Exported Variables --------------------------------------------------------*/
+
+/* 1. Global Variables */
+
+/* Exported Functions --------------------------------------------------------*/
+
+/* 1. Global Function Declarations */
+
+/*!
+ * @fn     return_t ButtonMatrix_Init(ButtonMatrix_t *matrix, GPIO_TypeDef *rowPort, uint16_t rowMask, GPIO_TypeDef *colPort, uint16_t colMask).
+ * @brief  Initializes an empty matrix and releases all rows.
+ * @param  matrix Pointer to the ButtonMatrix_t structure.
+ * @param  rowPort GPIO port of the row pins.
+ * @param  rowMask Row pins (e.g., GPIO_PIN_0 | GPIO_PIN_1 | ...).
+ * @param  colPort GPIO port of the column pins.
+ * @param  colMask Column pins, must be consecutive.
+ * @return return_t Returns return_success, or return_failed when the columns
+ *         are not consecutive, rows and columns overlap or the matrix has
+ *         more than BUTTON_MATRIX_MAX_KEYS keys.
+ * @note   The pins must already be configured (e.g., by CubeMX).
+ */
+return_t ButtonMatrix_Init(ButtonMatrix_t *matrix, GPIO_TypeDef *rowPort,
+		uint16_t rowMask, GPIO_TypeDef *colPort, uint16_t colMask);
+
+/*!
+ * @fn     return_t ButtonMatrix_Add(ButtonMatrix_t *matrix, Button_t *button, uint8_t row).
+ * @brief  Attaches a key, set up by Button_Init on its column pin.
+ * @param  matrix Pointer to the ButtonMatrix_t structure.
+ * @param  button Pointer to a Button_t initialized on the column port and pin
+ *         with GPIO_PULLUP.
+ * @param  row Row index of the key.
+ * @return return_t Returns return_success, or return_failed when the pin is
+ *         not a column of the matrix, the row does not exist or the key is
+ *         already used.
+ * @note   The button is no longer read by Button_GetFinalCount, which keeps
+ *         reporting its counts as usual.
+ */
+return_t ButtonMatrix_Add(ButtonMatrix_t *matrix, Button_t *button,
+		uint8_t row);
+
+/*!
+ * @fn     void ButtonMatrix_Scan(ButtonMatrix_t *matrix).
+ * @brief  Scans all rows once per BUTTON_MATRIX_SAMPLE_MS and feeds the
+ *         debounced presses to the keys.
+ * @param  matrix Pointer to the ButtonMatrix_t structure.
+ * @return void
+ * @note   Call it before polling the keys with Button_GetFinalCount.
+ */
+void ButtonMatrix_Scan(ButtonMatrix_t *matrix);
+
+/*!
+ * @fn     void ButtonMatrix_ScanAt(ButtonMatrix_t *matrix, uint32_t now).
+ * @brief  Same as ButtonMatrix_Scan, with the tick snapshot of the pass.
+ * @param  matrix Pointer to the ButtonMatrix_t structure.
+ * @param  now Tick read once for the whole pass (SOFTTIMER_TICK()).
+ * @return void
+ */
+void ButtonMatrix_ScanAt(ButtonMatrix_t *matrix, uint32_t now);
+
+#endif /* BUTTON_MATRIX_H */
+
+/* ******************** (C) COPYRIGHT [KeyhanSalehi] ******************* */
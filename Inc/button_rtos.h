@@ -0,0 +1,138 @@
+/*!
+ *******************************************************************************
+ * @file           : button_rtos.h
+ * @author         : KeyhanSalehi
+ * @brief          : Header file for the FreeRTOS task adapter.
+ *******************************************************************************
+ * @attention
+ *
+ * Runs the button engine in its own FreeRTOS task. The task sleeps on its
+ * task notification until the next deadline of its buttons (nothing pending
+ * means no wakeup at all), the EXTI interrupt wakes it with a notification,
+ * and every button event leaves through a FreeRTOS queue.
+ *
+ *******************************************************************************
+ */
+
+#ifndef BUTTON_RTOS_H
+#define BUTTON_RTOS_H
+
+/* Includes ------------------------------------------------------------------*/
+
+/* 1. System Header Files */
+#include <Common.h>
+/* 2. Project Header Files */
+#include "button_handler.h"
+
+/* Defines & Macros ----------------------------------------------------------*/
+
+/*!
+ * @def   BUTTON_RTOS_ENABLE
+ * @brief Build the FreeRTOS task adapter (1) or leave it out (0).
+ * @note  Needs FreeRTOS with configUSE_TASK_NOTIFICATIONS.
+ */
+#ifndef BUTTON_RTOS_ENABLE
+#define BUTTON_RTOS_ENABLE 0
+#endif
+
+#if BUTTON_RTOS_ENABLE
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+
+/*! @def @brief number of events the result queue can hold. */
+#ifndef BUTTON_RTOS_QUEUE_LENGTH
+#define BUTTON_RTOS_QUEUE_LENGTH 8U
+#endif
+
+/*! @def @brief stack depth of the button task, in words. */
+#ifndef BUTTON_RTOS_STACK_WORDS
+#define BUTTON_RTOS_STACK_WORDS 256U
+#endif
+
+/*!
+ * @def   BUTTON_RTOS_IDLE_WAIT
+ * @brief Longest sleep of the task when no button has a deadline, in RTOS ticks.
+ * @note  Keep portMAX_DELAY with EXTI (or externally scanned) buttons. Polled
+ *        buttons need it shortened (e.g., pdMS_TO_TICKS(10)) to sample their pin.
+ */
+#ifndef BUTTON_RTOS_IDLE_WAIT
+#define BUTTON_RTOS_IDLE_WAIT portMAX_DELAY
+#endif
+
+/* Typedefs ------------------------------------------------------------------*/
+
+/*!
+ * @struct
+ * @brief Button task and its result queue.
+ */
+typedef struct {
+	Button_t *buttons; /**< Buttons served by the task. */
+	size_t count; /**< Number of buttons. */
+	TaskHandle_t task; /**< Button task. */
+	QueueHandle_t queue; /**< Results, one ButtonEvent_t per item. */
+	ButtonEventQueue_t events; /**< Events published by Button_Process inside the task. */
+	uint32_t dropped; /**< Events lost because the result queue was full. */
+} ButtonRtos_t;
+
+/* Exported Variables --------------------------------------------------------*/
+
+/* 1. Global Variables */
+
+/* Exported Functions --------------------------------------------------------*/
+
+/* 1. Global Function Declarations */
+
+/*!
+ * @fn     return_t ButtonRtos_Start(ButtonRtos_t *rtos, Button_t *buttons, size_t count, UBaseType_t priority).
+ * @brief  Creates the result queue and the task serving the buttons.
+ * @param  rtos Pointer to the ButtonRtos_t structure.
+ * @param  buttons Array of initialized buttons.
+ * @param  count Number of buttons in the array.
+ * @param  priority Priority of the button task.
+ * @return return_t Returns return_success, or return_failed when the queue
+ *         or the task cannot be created.
+ * @note   The task takes over Button_SetEventQueue, only it may call
+ *         Button_Process afterwards.
+ */
+return_t ButtonRtos_Start(ButtonRtos_t *rtos, Button_t *buttons, size_t count,
+		UBaseType_t priority);
+
+/*!
+ * @fn     return_t ButtonRtos_Receive(ButtonRtos_t *rtos, ButtonEvent_t *event, TickType_t wait).
+ * @brief  Takes the oldest result, blocking up to wait RTOS ticks.
+ * @param  rtos Pointer to the ButtonRtos_t structure.
+ * @param  event Pointer to store the event.
+ * @param  wait Ticks to block (0 polls, portMAX_DELAY waits forever).
+ * @return return_t Returns return_success, or return_busy when no event came.
+ */
+return_t ButtonRtos_Receive(ButtonRtos_t *rtos, ButtonEvent_t *event,
+		TickType_t wait);
+
+/*!
+ * @fn     void ButtonRtos_NotifyFromISR(ButtonRtos_t *rtos).
+ * @brief  Wakes the button task, call from an interrupt.
+ * @param  rtos Pointer to the ButtonRtos_t structure.
+ * @return void
+ * @note   E.g. after ButtonBank_Feed in a DMA or timer interrupt.
+ */
+void ButtonRtos_NotifyFromISR(ButtonRtos_t *rtos);
+
+#if BUTTON_EXTI_ENABLE
+/*!
+ * @fn     void ButtonRtos_EdgeFromISR(ButtonRtos_t *rtos, Button_t *button).
+ * @brief  Timestamps an EXTI edge of the button and wakes the task, call
+ *         from the EXTI ISR instead of Button_EXTI_Callback.
+ * @param  rtos Pointer to the ButtonRtos_t structure.
+ * @param  button Pointer to the Button_t structure.
+ * @return void
+ */
+void ButtonRtos_EdgeFromISR(ButtonRtos_t *rtos, Button_t *button);
+#endif
+
+#endif /* BUTTON_RTOS_ENABLE */
+
+#endif /* BUTTON_RTOS_H */
+
+/* ******************** (C) COPYRIGHT [KeyhanSalehi] ******************* */
@@ -0,0 +1,88 @@
+/*!
+ *******************************************************************************
+ * @file           : button_table.h
+ * @author         : KeyhanSalehi
+ * @brief          : Compile-time button tables (X-macros).
+ *******************************************************************************
+ * @attention
+ *
+ * Declare the whole button set once as an X-macro list, then expand it into
+ * an id enum, a const ButtonConfig_t table (flash) and a Button_t array
+ * (RAM, mutable state only when BUTTON_CONFIG_IN_FLASH is set):
+ *
+ *   #define APP_BUTTONS(X) \
+ *       X(KEY_OK,   GPIOA, GPIO_PIN_0, GPIO_PULLUP,   50, 1000, 5) \
+ *       X(KEY_BACK, GPIOB, GPIO_PIN_1, GPIO_PULLDOWN, 20,  300, 1)
+ *
+ *   BUTTON_TABLE_DECLARE(appButtons, APP_BUTTONS)   (header)
+ *   BUTTON_TABLE_DEFINE(appButtons, APP_BUTTONS)    (one source file)
+ *   BUTTON_TABLE_INIT(appButtons);                  (startup)
+ *
+ * Entry: X(name, port, pin, pull, debounceMs, timeoutMs, maxCount).
+ * Button ids are the enum values, appButtons[KEY_OK] is the KEY_OK button.
+ *
+ *******************************************************************************
+ */
+
+#ifndef BUTTON_TABLE_H
+#define BUTTON_TABLE_H
+
+/* Includes ------------------------------------------------------------------*/
+
+/* 1. System Header Files */
+#include <Common.h>
+/* 2. Project Header Files */
+#include "button_handler.h"
+
+/* Defines & Macros ----------------------------------------------------------*/
+
+/*! @def @brief X-macro expanding one entry to its enum id. */
+#define BUTTON_TABLE_ID(name, port, pin, pull, debounceMs, timeoutMs, maxCount) \
+		name,
+
+/*! @def @brief X-macro expanding one entry to its const configuration. */
+#define BUTTON_TABLE_CONFIG(name, port, pin, pull, debounceMs, timeoutMs, maxCount) \
+		[name] = BUTTON_CONFIG_INIT(port, pin, pull, debounceMs, timeoutMs, maxCount),
+
+/*!
+ * @def   BUTTON_TABLE_DECLARE
+ * @brief Declares the id enum, the config table and the button array.
+ * @param table Name of the Button_t array (table##Config, table##_COUNT).
+ * @param LIST  X-macro list of the buttons.
+ */
+#define BUTTON_TABLE_DECLARE(table, LIST) \
+		enum { LIST(BUTTON_TABLE_ID) table##_COUNT }; \
+		extern const ButtonConfig_t table##Config[table##_COUNT]; \
+		extern Button_t table[table##_COUNT]
+
+/*!
+ * @def   BUTTON_TABLE_DEFINE
+ * @brief Defines the const config table and the button array.
+ * @param table Name of the Button_t array.
+ * @param LIST  X-macro list of the buttons.
+ */
+#define BUTTON_TABLE_DEFINE(table, LIST) \
+		const ButtonConfig_t table##Config[table##_COUNT] = { LIST(BUTTON_TABLE_CONFIG) }; \
+		Button_t table[table##_COUNT]
+
+/*!
+ * @def   BUTTON_TABLE_INIT
+ * @brief Initializes every button of a table, call once at startup.
+ * @param table Name of the Button_t array.
+ */
+#define BUTTON_TABLE_INIT(table) \
+		Button_InitTable((table), (table##Config), (size_t) (table##_COUNT))
+
+/* Typedefs ------------------------------------------------------------------*/
+
+/* Exported Variables --------------------------------------------------------*/
+
+/* 1. Global Variables */
+
+/* Exported Functions --------------------------------------------------------*/
+
+/* 1. Global Function Declarations */
+
+#endif /* BUTTON_TABLE_H */
+
+/* ******************** (C) COPYRIGHT [KeyhanSalehi] ******************* */
@@ -0,0 +1,121 @@
+/*!
+ *******************************************************************************
+ * @file           : button_tally.h
+ * @author         : KeyhanSalehi
+ * @brief          : Header file for the packed click tally of a bank port.
+ *******************************************************************************
+ * @attention
+ *
+ * Counts the clicks of up to 16 bank pins (ButtonBank_AddPin) without a
+ * Button_t per pin: the counts are BUTTON_TALLY_BITS-wide fields packed into
+ * shared words, and the whole port has one timeout. The sequences of a port
+ * close together once all its pins were released for BUTTON_TIMEOUT_MS, so
+ * 16 buttons cost about 20 bytes of RAM with 4-bit counts.
+ *
+ *******************************************************************************
+ */
+
+#ifndef BUTTON_TALLY_H
+#define BUTTON_TALLY_H
+
+/* Includes ------------------------------------------------------------------*/
+
+/* 1. System Header Files */
+#include <Common.h>
+/* 2. Project Header Files */
+#include "button_bank.h"
+
+/* Defines & Macros ----------------------------------------------------------*/
+
+/*! @def @brief width of one packed count in bits (2, 4 or 8). */
+#ifndef BUTTON_TALLY_BITS
+#define BUTTON_TALLY_BITS 4U
+#endif
+
+#if BUTTON_TALLY_BITS != 2U && BUTTON_TALLY_BITS != 4U && BUTTON_TALLY_BITS != 8U
+#error "BUTTON_TALLY_BITS must be 2, 4 or 8"
+#endif
+
+/*! @def @brief counts held by one word. */
+#define BUTTON_TALLY_PER_WORD (32U / BUTTON_TALLY_BITS)
+
+/*! @def @brief words holding the counts of one port. */
+#define BUTTON_TALLY_WORDS \
+		((BUTTON_BANK_PORT_PINS + BUTTON_TALLY_PER_WORD - 1U) / BUTTON_TALLY_PER_WORD)
+
+/*! @def @brief mask of one count field. */
+#define BUTTON_TALLY_FIELD ((1UL << BUTTON_TALLY_BITS) - 1U)
+
+/*! @def @brief highest max count, the top field value marks an overflow. */
+#define BUTTON_TALLY_MAX_COUNT ((uint8_t) (BUTTON_TALLY_FIELD - 1U))
+
+/* Typedefs ------------------------------------------------------------------*/
+
+/*!
+ * @struct
+ * @brief Packed click counts of one bank port.
+ */
+typedef struct {
+	ButtonBankPort_t *bankPort; /**< Port slot the pins live on. */
+	uint32_t counts[BUTTON_TALLY_WORDS]; /**< Count of pin n in field n. */
+	uint16_t lastPressed; /**< Pressed mask of the previous update. */
+	uint8_t maxCount; /**< Highest valid count of every pin. */
+	uint8_t idBase; /**< Event id of pin 0, pin n reports idBase + n. */
+	softTimer_t timeoutTimer; /**< Tick of the last press or release. */
+} ButtonTally_t;
+
+/* Exported Variables --------------------------------------------------------*/
+
+/* 1. Global Variables */
+
+/* Exported Functions (Inline) -----------------------------------------------*/
+
+/*!
+ * @fn     static inline uint8_t ButtonTally_Count(const ButtonTally_t *tally, uint8_t bit).
+ * @brief  Gets the count of a pin in the sequence in progress.
+ * @param  tally Pointer to the ButtonTally_t structure.
+ * @param  bit Pin bit number (0 for GPIO_PIN_0...).
+ * @return uint8_t Count so far, above the max count after an overflow.
+ */
+static inline uint8_t ButtonTally_Count(const ButtonTally_t *tally, uint8_t bit) {
+	return (uint8_t) ((tally->counts[bit / BUTTON_TALLY_PER_WORD]
+			>> ((bit % BUTTON_TALLY_PER_WORD) * BUTTON_TALLY_BITS))
+			& BUTTON_TALLY_FIELD);
+}
+
+/* Exported Functions --------------------------------------------------------*/
+
+/* 1. Global Function Declarations */
+
+/*!
+ * @fn     void ButtonTally_Init(ButtonTally_t *tally, ButtonBankPort_t *bankPort, uint8_t maxCount, uint8_t idBase).
+ * @brief  Initializes the tally of a bank port.
+ * @param  tally Pointer to the ButtonTally_t structure.
+ * @param  bankPort Pointer to the port slot (ButtonBank_FindPort).
+ * @param  maxCount Highest valid count, clamped to BUTTON_TALLY_MAX_COUNT.
+ * @param  idBase Event id of pin 0.
+ * @return void
+ */
+void ButtonTally_Init(ButtonTally_t *tally, ButtonBankPort_t *bankPort,
+		uint8_t maxCount, uint8_t idBase);
+
+/*!
+ * @fn     size_t ButtonTally_Update(ButtonTally_t *tally, uint32_t now, ButtonResult_t *results).
+ * @brief  Counts the new presses of the last scan and closes idle sequences.
+ * @param  tally Pointer to the ButtonTally_t structure.
+ * @param  now Tick of the pass (SOFTTIMER_TICK()).
+ * @param  results Array of BUTTON_BANK_PORT_PINS entries for the closed
+ *         counts (index is the pin bit), or NULL.
+ * @return size_t Number of valid counts closed by this call.
+ * @note   Call it right after ButtonBank_Scan, in the same context as the
+ *         other producers of the event queue. Presses beyond the max count
+ *         follow BUTTON_OVERFLOW_POLICY; with BUTTON_OVERFLOW_RESET the pin
+ *         reports nothing. Closed counts are also published as
+ *         BUTTON_EVENT_CLICKS.
+ */
+size_t ButtonTally_Update(ButtonTally_t *tally, uint32_t now,
+		ButtonResult_t *results);
+
+#endif /* BUTTON_TALLY_H */
+
+/* ******************** (C) COPYRIGHT [KeyhanSalehi] ******************* */
@@ -0,0 +1,170 @@
+/*!
+ *******************************************************************************
+ * @file           : button_trace.h
+ * @author         : KeyhanSalehi
+ * @brief          : Header file for the button edge trace recorder.
+ *******************************************************************************
+ * @attention
+ *
+ * Records the raw pin edges of chosen buttons as delta-encoded 16-bit words
+ * in a fixed RAM ring, dumps them as text over UART/SWO, and (in host
+ * simulation builds) loads and replays a dump through the button engine.
+ *
+ * Record word: bit 15 is the pin level after the edge, bits 14..0 the ticks
+ * since the previous record (0..0x7FFE, ms at the default 1 tick per ms).
+ * 0x7FFF in bits 14..0 is a time-only record: the next word n (1..0x7FFE)
+ * moves time forward by n * 0x7FFF ticks, without an edge. Edge deltas and n never reach 0x7FFF, so
+ * the dump of a wrapped ring can drop a partial record at its start.
+ *
+ * Dump: "BTRACE 2 <id> <count>", the records in hex oldest first, "END".
+ *
+ *******************************************************************************
+ */
+
+#ifndef BUTTON_TRACE_H
+#define BUTTON_TRACE_H
+
+/* Includes ------------------------------------------------------------------*/
+
+/* 1. System Header Files */
+#include <Common.h>
+/* 2. Project Header Files */
+#include "button_handler.h"
+
+#if BUTTON_TRACE_ENABLE
+
+/* Defines & Macros ----------------------------------------------------------*/
+
+/*! @def @brief records kept per trace, the oldest are overwritten (power of 2). */
+#ifndef BUTTON_TRACE_SIZE
+#define BUTTON_TRACE_SIZE 256U
+#endif
+
+#if (BUTTON_TRACE_SIZE & (BUTTON_TRACE_SIZE - 1U)) != 0U
+#error "BUTTON_TRACE_SIZE must be a power of 2"
+#endif
+
+/*! @def @brief record fields. */
+#define BUTTON_TRACE_LEVEL 0x8000U /**< Pin level after the edge. */
+#define BUTTON_TRACE_DELTA 0x7FFFU /**< Ticks since the previous record. */
+#define BUTTON_TRACE_SKIP BUTTON_TRACE_DELTA /**< Delta of a time-only record. */
+#define BUTTON_TRACE_UNITS_MAX 0x7FFEU /**< Highest word after a time-only record. */
+
+/*! @def @brief format version written in dumps. */
+#define BUTTON_TRACE_VERSION 2U
+
+/* Typedefs ------------------------------------------------------------------*/
+
+/*!
+ * @struct
+ * @brief Edge ring of one button.
+ * @note  Written by the button engine, read by ButtonTrace_Dump.
+ */
+struct ButtonTrace {
+	uint16_t records[BUTTON_TRACE_SIZE]; /**< Delta-encoded edges. */
+	volatile uint32_t head; /**< Free-running count of written records. */
+	uint32_t lastTick; /**< Tick of the previous record. */
+	uint8_t lastLevel; /**< Pin level of the previous record. */
+	uint8_t id; /**< Id of the traced button. */
+};
+
+/*!
+ * @brief Output of ButtonTrace_Dump, e.g. a wrapper of HAL_UART_Transmit.
+ */
+typedef void (*ButtonTraceWrite_t)(const char *text, size_t length);
+
+#if defined(HOST_SIM) && HOST_SIM
+/*!
+ * @brief Result of a replayed poll, see ButtonTrace_Replay.
+ */
+typedef void (*ButtonTraceResult_t)(uint32_t tick, uint8_t count);
+#endif
+
+/* Exported Variables --------------------------------------------------------*/
+
+/* 1. Global Variables */
+
+/* Exported Functions --------------------------------------------------------*/
+
+/* 1. Global Function Declarations */
+
+/*!
+ * @fn     void ButtonTrace_Attach(ButtonTrace_t *trace, Button_t *button).
+ * @brief  Clears a trace and starts recording the edges of a button into it.
+ * @param  trace Pointer to the ButtonTrace_t structure.
+ * @param  button Pointer to an initialized Button_t (polled or EXTI).
+ * @return void
+ * @note   Banked buttons do not sample their own pin and are not traced.
+ */
+void ButtonTrace_Attach(ButtonTrace_t *trace, Button_t *button);
+
+/*!
+ * @fn     void ButtonTrace_Detach(Button_t *button).
+ * @brief  Stops recording a button, its trace keeps the records.
+ * @param  button Pointer to the Button_t structure.
+ * @return void
+ */
+void ButtonTrace_Detach(Button_t *button);
+
+/*!
+ * @fn     void ButtonTrace_Record(ButtonTrace_t *trace, uint32_t tick, uint8_t level).
+ * @brief  Appends one edge, called by the button engine.
+ * @param  trace Pointer to the ButtonTrace_t structure.
+ * @param  tick Tick of the edge.
+ * @param  level Pin level after the edge (GPIO_PinState).
+ * @return void
+ */
+void ButtonTrace_Record(ButtonTrace_t *trace, uint32_t tick, uint8_t level);
+
+/*!
+ * @fn     size_t ButtonTrace_Count(const ButtonTrace_t *trace).
+ * @brief  Gets the number of records held by a trace.
+ * @param  trace Pointer to the ButtonTrace_t structure.
+ * @return size_t Records available, at most BUTTON_TRACE_SIZE.
+ */
+size_t ButtonTrace_Count(const ButtonTrace_t *trace);
+
+/*!
+ * @fn     void ButtonTrace_Dump(const ButtonTrace_t *trace, ButtonTraceWrite_t write).
+ * @brief  Writes the records of a trace as text, oldest first.
+ * @param  trace Pointer to the ButtonTrace_t structure.
+ * @param  write Output function (UART, SWO...).
+ * @return void
+ * @note   Detach the button first so the ring does not move while dumping.
+ */
+void ButtonTrace_Dump(const ButtonTrace_t *trace, ButtonTraceWrite_t write);
+
+#if defined(HOST_SIM) && HOST_SIM
+/*!
+ * @fn     size_t ButtonTrace_Load(const char *text, uint16_t *records, size_t maxRecords, uint8_t *id).
+ * @brief  Parses a dump written by ButtonTrace_Dump.
+ * @param  text Dump text, NUL terminated.
+ * @param  records Array receiving the records.
+ * @param  maxRecords Capacity of records.
+ * @param  id Pointer to store the button id of the dump.
+ * @return size_t Number of records loaded, 0 if no dump was found.
+ */
+size_t ButtonTrace_Load(const char *text, uint16_t *records, size_t maxRecords,
+		uint8_t *id);
+
+/*!
+ * @fn     void ButtonTrace_Replay(Button_t *button, const uint16_t *records, size_t count, ButtonTraceResult_t result).
+ * @brief  Drives a button's simulated pin with a trace and polls it every tick.
+ * @param  button Pointer to a polled Button_t on a simulated port.
+ * @param  records Records of the trace.
+ * @param  count Number of records.
+ * @param  result Called with every valid count Button_GetFinalCount reports.
+ * @return void
+ * @note   Runs from the current virtual tick, and one timeout past the last
+ *         edge so the final sequence closes. With BUTTON_TIMER_WHEEL_ENABLE
+ *         the wheel of Button_GetTimerWheel is processed before every poll.
+ */
+void ButtonTrace_Replay(Button_t *button, const uint16_t *records, size_t count,
+		ButtonTraceResult_t result);
+#endif /* HOST_SIM */
+
+#endif /* BUTTON_TRACE_ENABLE */
+
+#endif /* BUTTON_TRACE_H */
+
+/* ******************** (C) COPYRIGHT [KeyhanSalehi] ******************* */
@@ -0,0 +1,79 @@
+/**
+ *******************************************************************************
+ * @file           : button_vcounter.h
+ * @author         : KeyhanSalehi
+ * @brief          : Bit-parallel (vertical counter) debounce for 32 lanes
+ *******************************************************************************
+ * @attention
+ *
+ * Each bit lane is one input. Two 32-bit words hold a 2-bit down counter per
+ * lane, so a lane toggles its debounced state only after it differs from it
+ * in BUTTON_VCOUNTER_SAMPLES consecutive samples. A whole port costs a
+ * handful of XOR/AND operations per sample, whatever the number of pins.
+ *
+ *******************************************************************************
+ */
+
+#ifndef INC_BUTTON_VCOUNTER_H_
+#define INC_BUTTON_VCOUNTER_H_
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+
+/* Defines & Macros ----------------------------------------------------------*/
+
+/**
+ * @brief Consecutive equal samples needed to change a lane (2-bit counter)
+ */
+#define BUTTON_VCOUNTER_SAMPLES   4U
+
+/* Typedefs ------------------------------------------------------------------*/
+
+/**
+ * @brief Vertical counter state of up to 32 lanes
+ */
+typedef struct {
+    uint32_t ct0;   /*!< Bit 0 of every lane counter */
+    uint32_t ct1;   /*!< Bit 1 of every lane counter */
+    uint32_t state; /*!< Debounced state, one bit per lane */
+} ButtonVCounter_t;
+
+/* Exported Functions (Inline) -----------------------------------------------*/
+
+/**
+ * @fn    static inline void ButtonVCounter_init(ButtonVCounter_t*, uint32_t)
+ * @brief Reset all lane counters and set the debounced state
+ * @param vc    Pointer to vertical counter
+ * @param state Initial debounced state
+ */
+static inline void ButtonVCounter_init(ButtonVCounter_t *vc, uint32_t state)
+{
+    vc->ct0 = 0xFFFFFFFFU;
+    vc->ct1 = 0xFFFFFFFFU;
+    vc->state = state;
+}
+
+/**
+ * @fn    static inline uint32_t ButtonVCounter_update(ButtonVCounter_t*, uint32_t)
+ * @brief Feed one sample of all lanes
+ * @param vc     Pointer to vertical counter
+ * @param sample Raw sample, one bit per lane
+ * @return Mask of the lanes whose debounced state toggled with this sample
+ */
+static inline uint32_t ButtonVCounter_update(ButtonVCounter_t *vc,
+        uint32_t sample)
+{
+    uint32_t delta = sample ^ vc->state;   /* lanes away from their state */
+    uint32_t toggle;
+
+    vc->ct0 = ~(vc->ct0 & delta);          /* equal lanes reload to 3 */
+    vc->ct1 = vc->ct0 ^ (vc->ct1 & delta);
+    toggle = delta & vc->ct0 & vc->ct1;    /* counter wrapped */
+    vc->state ^= toggle;
+
+    return toggle;
+}
+
+#endif /* INC_BUTTON_VCOUNTER_H_ */
+
+/************************ (C) COPYRIGHT KeyhanSalehi *****END OF FILE****/
@@ -0,0 +1,192 @@
+/*!
+ *******************************************************************************
+ * @file           : host_sim.h
+ * @author         : KeyhanSalehi
+ * @brief          : Fake HAL for host (x86) builds of the Button Handler.
+ *******************************************************************************
+ * @attention
+ *
+ * Replaces main.h when HOST_SIM is defined to 1: GPIO ports are plain RAM
+ * structures whose IDR the test writes, and HAL_GetTick returns a virtual
+ * clock the test advances. Only the HAL subset used by the library is
+ * provided (no TIM, DMA or DWT).
+ *
+ *******************************************************************************
+ */
+
+#ifndef HOST_SIM_H
+#define HOST_SIM_H
+
+/* Includes ------------------------------------------------------------------*/
+
+/* 1. System Header Files */
+#include <stdint.h>
+#include <stdbool.h>
+/* 2. Project Header Files */
+
+/* Defines & Macros ----------------------------------------------------------*/
+
+/*! @def @brief number of simulated GPIO ports (GPIOA...). */
+#ifndef HOST_SIM_PORTS
+#define HOST_SIM_PORTS 8U
+#endif
+
+/*! @def @brief simulated GPIO ports. */
+#define GPIOA (&hostSimPorts[0])
+#define GPIOB (&hostSimPorts[1])
+#define GPIOC (&hostSimPorts[2])
+#define GPIOD (&hostSimPorts[3])
+#define GPIOE (&hostSimPorts[4])
+#define GPIOF (&hostSimPorts[5])
+#define GPIOG (&hostSimPorts[6])
+#define GPIOH (&hostSimPorts[7])
+#define GPIOA_BASE ((uintptr_t) &hostSimPorts[0])
+
+/*! @def @brief ports are contiguous in RAM, not 0x400 apart. */
+#define BUTTON_GPIO_STRIDE ((uintptr_t) sizeof(GPIO_TypeDef))
+
+/*! @def @brief GPIO pins, as in the HAL. */
+#define GPIO_PIN_0 ((uint16_t) 0x0001)
+#define GPIO_PIN_1 ((uint16_t) 0x0002)
+#define GPIO_PIN_2 ((uint16_t) 0x0004)
+#define GPIO_PIN_3 ((uint16_t) 0x0008)
+#define GPIO_PIN_4 ((uint16_t) 0x0010)
+#define GPIO_PIN_5 ((uint16_t) 0x0020)
+#define GPIO_PIN_6 ((uint16_t) 0x0040)
+#define GPIO_PIN_7 ((uint16_t) 0x0080)
+#define GPIO_PIN_8 ((uint16_t) 0x0100)
+#define GPIO_PIN_9 ((uint16_t) 0x0200)
+#define GPIO_PIN_10 ((uint16_t) 0x0400)
+#define GPIO_PIN_11 ((uint16_t) 0x0800)
+#define GPIO_PIN_12 ((uint16_t) 0x1000)
+#define GPIO_PIN_13 ((uint16_t) 0x2000)
+#define GPIO_PIN_14 ((uint16_t) 0x4000)
+#define GPIO_PIN_15 ((uint16_t) 0x8000)
+#define GPIO_PIN_All ((uint16_t) 0xFFFF)
+
+/*! @def @brief pull configurations, as in the HAL. */
+#define GPIO_NOPULL 0x00000000U
+#define GPIO_PULLUP 0x00000001U
+#define GPIO_PULLDOWN 0x00000002U
+
+/*! @def @brief core intrinsics used by the library. */
+#define __DMB() __sync_synchronize()
+#define __WFI() ((void) 0)
+#define __NOP() ((void) 0)
+#define __disable_irq() ((void) 0)
+#define __enable_irq() ((void) 0)
+#define __get_IPSR() 0U
+
+/* Typedefs ------------------------------------------------------------------*/
+
+/*!
+ * @struct
+ * @brief Simulated GPIO port, the test drives IDR.
+ */
+typedef struct {
+	volatile uint32_t IDR; /**< Input levels, written by the test. */
+	volatile uint32_t ODR; /**< Output levels, written by HAL_GPIO_WritePin. */
+} GPIO_TypeDef;
+
+/*!
+ * @enum
+ * @brief Pin state, as in the HAL.
+ */
+typedef enum {
+	GPIO_PIN_RESET = 0U,
+	GPIO_PIN_SET
+} GPIO_PinState;
+
+/*!
+ * @enum
+ * @brief HAL status, as in the HAL.
+ */
+typedef enum {
+	HAL_OK = 0x00U,
+	HAL_ERROR = 0x01U,
+	HAL_BUSY = 0x02U,
+	HAL_TIMEOUT = 0x03U
+} HAL_StatusTypeDef;
+
+/* Exported Variables --------------------------------------------------------*/
+
+/* 1. Global Variables */
+
+/*! @brief simulated GPIO ports. */
+extern GPIO_TypeDef hostSimPorts[HOST_SIM_PORTS];
+
+/* Exported Functions --------------------------------------------------------*/
+
+/* 1. Global Function Declarations */
+
+/*!
+ * @fn     uint32_t HAL_GetTick(void).
+ * @brief  Gets the virtual clock.
+ * @return uint32_t Current virtual tick in ms.
+ */
+uint32_t HAL_GetTick(void);
+
+/*!
+ * @fn     GPIO_PinState HAL_GPIO_ReadPin(GPIO_TypeDef *port, uint16_t pin).
+ * @brief  Reads a pin of a simulated port.
+ * @param  port GPIO port.
+ * @param  pin GPIO pin.
+ * @return GPIO_PinState Level of the pin in IDR.
+ */
+GPIO_PinState HAL_GPIO_ReadPin(GPIO_TypeDef *port, uint16_t pin);
+
+/*!
+ * @fn     void HAL_GPIO_WritePin(GPIO_TypeDef *port, uint16_t pin, GPIO_PinState state).
+ * @brief  Writes a pin of a simulated port.
+ * @param  port GPIO port.
+ * @param  pin GPIO pin.
+ * @param  state Level to write to ODR.
+ * @return void
+ */
+void HAL_GPIO_WritePin(GPIO_TypeDef *port, uint16_t pin, GPIO_PinState state);
+
+/*!
+ * @fn     void HostSim_Reset(void).
+ * @brief  Clears every simulated port and sets the virtual clock to 0.
+ * @return void
+ */
+void HostSim_Reset(void);
+
+/*!
+ * @fn     void HostSim_SetTick(uint32_t tick).
+ * @brief  Sets the virtual clock.
+ * @param  tick New virtual tick in ms.
+ * @return void
+ */
+void HostSim_SetTick(uint32_t tick);
+
+/*!
+ * @fn     void HostSim_Advance(uint32_t ms).
+ * @brief  Moves the virtual clock forward.
+ * @param  ms Number of ms to add.
+ * @return void
+ */
+void HostSim_Advance(uint32_t ms);
+
+/*!
+ * @fn     void HostSim_SetPin(GPIO_TypeDef *port, uint16_t pin, GPIO_PinState state).
+ * @brief  Drives the input level of a simulated pin.
+ * @param  port GPIO port.
+ * @param  pin GPIO pin mask.
+ * @param  state Level to apply to IDR.
+ * @return void
+ */
+void HostSim_SetPin(GPIO_TypeDef *port, uint16_t pin, GPIO_PinState state);
+
+/*!
+ * @fn     void HostSim_SetPort(GPIO_TypeDef *port, uint16_t levels).
+ * @brief  Drives the input levels of a whole simulated port.
+ * @param  port GPIO port.
+ * @param  levels New IDR value.
+ * @return void
+ */
+void HostSim_SetPort(GPIO_TypeDef *port, uint16_t levels);
+
+#endif /* HOST_SIM_H */
+
+/* ******************** (C) COPYRIGHT [KeyhanSalehi] ******************* */
@@ -16,9 +16,14 @@
 #define INC_SOFTTIMER_H_
 
 /* Includes ------------------------------------------------------------------*/
+#include <stddef.h>
 #include <stdint.h>
 #include <stdbool.h>
+#if defined(HOST_SIM) && HOST_SIM
+#include "host_sim.h"   /* fake HAL for host builds */
+#else
 #include "main.h"   /* this file generated by cubeMx */
+#endif
 
 /* Defines & Macros ----------------------------------------------------------*/
 
@@ -31,6 +36,19 @@
 #define SOFTTIMER_TICK()   HAL_GetTick()
 #endif
 
+/**
+ * @brief Rate of the tick source in ticks per millisecond
+ * @note  1 for HAL_GetTick(). Set it to 1000 together with a SOFTTIMER_TICK()
+ *        reading a free-running 32-bit 1 MHz timer counter (e.g. TIM2->CNT)
+ *        for microsecond resolution; 32-bit ticks then wrap every 71 minutes.
+ */
+#ifndef SOFTTIMER_TICKS_PER_MS
+#define SOFTTIMER_TICKS_PER_MS   1U
+#endif
+
+#define SOFTTIMER_MS_TO_TICKS(ms)     ((uint32_t)(ms) * SOFTTIMER_TICKS_PER_MS)  /*!< ms to ticks */
+#define SOFTTIMER_TICKS_TO_MS(ticks)  ((uint32_t)(ticks) / SOFTTIMER_TICKS_PER_MS)  /*!< Ticks to ms */
+
 /**
  * @brief Time Conversion Macros
  */
@@ -39,6 +57,19 @@
 #define MS_TO_US(ms)     ((uint32_t)((ms) * 1000U))           /*!< Milliseconds to us */
 #define SEC_TO_US(sec)   ((uint32_t)((sec) * 1000000U))       /*!< Seconds to us */
 
+/**
+ * @brief Number of slots of a timer wheel (power of 2)
+ * @note  A timer is hashed to slot (deadline % slots), so one processed tick
+ *        only visits the timers of a single slot.
+ */
+#ifndef SOFTTIMER_WHEEL_SLOTS
+#define SOFTTIMER_WHEEL_SLOTS   32U
+#endif
+
+#if (SOFTTIMER_WHEEL_SLOTS & (SOFTTIMER_WHEEL_SLOTS - 1U)) != 0U
+#error "SOFTTIMER_WHEEL_SLOTS must be a power of 2"
+#endif
+
 /* Typedefs ------------------------------------------------------------------*/
 
 /**
@@ -47,6 +78,41 @@
  */
 typedef uint32_t softTimer_t;
 
+/**
+ * @brief Compact software timer type
+ * @note  Holds the low 16 bits of the start tick, so only timeouts below
+ *        32768 ticks can be measured with it
+ */
+typedef uint16_t softTimer16_t;
+
+typedef struct softTimerNode softTimerNode_t;
+
+/**
+ * @brief Expiry callback of a wheel timer
+ * @note  Runs from softTimerWheel_process(); the node may be restarted in it
+ */
+typedef void (*softTimerCallback_t)(softTimerNode_t *node);
+
+/**
+ * @brief Deadline registered in a timer wheel
+ * @note  Initialize with softTimerWheel_initNode() before first use
+ */
+struct softTimerNode {
+    softTimerNode_t *next;         /*!< Next node in the same slot */
+    softTimerNode_t **pprev;       /*!< Link pointing at this node, NULL when stopped */
+    uint32_t deadline;             /*!< Tick at which the timer expires */
+    softTimerCallback_t callback;  /*!< Called on expiry */
+    void *context;                 /*!< User data for the callback */
+};
+
+/**
+ * @brief Hashed timer wheel shared by many deadlines
+ */
+typedef struct {
+    softTimerNode_t *slots[SOFTTIMER_WHEEL_SLOTS]; /*!< Timers hashed by deadline */
+    uint32_t lastTick;                             /*!< Last processed tick */
+} softTimerWheel_t;
+
 /* Exported Functions (Inline) -----------------------------------------------*/
 
 /**
@@ -63,7 +129,7 @@ static inline void softTimer_reset(softTimer_t *timer)
  * @fn    static inline bool softTimer_isElapsed(softTimer_t*, uint32_t)
  * @brief Check if timer has elapsed
  * @param timer   Pointer to timer variable
- * @param timeout Timeout in milliseconds
+ * @param timeout Timeout in ticks (SOFTTIMER_MS_TO_TICKS)
  * @return true if timeout elapsed, false otherwise
  */
 static inline bool softTimer_isElapsed(softTimer_t *timer, uint32_t timeout)
@@ -71,6 +137,135 @@ static inline bool softTimer_isElapsed(softTimer_t *timer, uint32_t timeout)
     return ((uint32_t)(SOFTTIMER_TICK() - *timer) >= timeout);
 }
 
+/**
+ * @fn    static inline void softTimer_resetAt(softTimer_t*, uint32_t)
+ * @brief Reset timer start tick to a given tick
+ * @param timer Pointer to timer variable
+ * @param tick  Tick the timer starts from (e.g. a captured edge timestamp)
+ */
+static inline void softTimer_resetAt(softTimer_t *timer, uint32_t tick)
+{
+    *timer = tick;
+}
+
+/**
+ * @fn    static inline bool softTimer_isElapsedAt(const softTimer_t*, uint32_t, uint32_t)
+ * @brief Check if timer has elapsed at a given tick
+ * @param timer   Pointer to timer variable
+ * @param now     Tick to evaluate the timer against
+ * @param timeout Timeout in ticks (SOFTTIMER_MS_TO_TICKS)
+ * @return true if timeout elapsed at tick now, false otherwise
+ */
+static inline bool softTimer_isElapsedAt(const softTimer_t *timer, uint32_t now,
+        uint32_t timeout)
+{
+    return ((uint32_t)(now - *timer) >= timeout);
+}
+
+/**
+ * @fn    static inline void softTimer16_resetAt(softTimer16_t*, uint32_t)
+ * @brief Reset compact timer start tick to a given tick
+ * @param timer Pointer to timer variable
+ * @param tick  Tick the timer starts from
+ */
+static inline void softTimer16_resetAt(softTimer16_t *timer, uint32_t tick)
+{
+    *timer = (softTimer16_t)tick;
+}
+
+/**
+ * @fn    static inline bool softTimer16_isElapsedAt(const softTimer16_t*, uint32_t, uint32_t)
+ * @brief Check if compact timer has elapsed at a given tick
+ * @param timer   Pointer to timer variable
+ * @param now     Tick to evaluate the timer against
+ * @param timeout Timeout in ticks (below 32768)
+ * @return true if timeout elapsed at tick now, false otherwise
+ */
+static inline bool softTimer16_isElapsedAt(const softTimer16_t *timer,
+        uint32_t now, uint32_t timeout)
+{
+    return ((uint16_t)((uint16_t)now - *timer) >= timeout);
+}
+
+/* Exported Functions --------------------------------------------------------*/
+
+/**
+ * @fn    uint64_t softTimer_tick64(void)
+ * @brief Monotonic 64-bit tick extended from SOFTTIMER_TICK()
+ * @return Ticks since startup, never wraps
+ * @note  Call it from one context, at least once per 32-bit wrap of the
+ *        tick source. 32-bit timers stay wrap-safe on their own as long as
+ *        the measured intervals are below 2^31 ticks.
+ */
+uint64_t softTimer_tick64(void);
+
+/**
+ * @fn    void softTimerWheel_init(softTimerWheel_t*)
+ * @brief Initialize an empty wheel starting at the current tick
+ * @param wheel Pointer to timer wheel
+ */
+void softTimerWheel_init(softTimerWheel_t *wheel);
+
+/**
+ * @fn    void softTimerWheel_initNode(softTimerNode_t*, softTimerCallback_t, void*)
+ * @brief Initialize a stopped wheel timer
+ * @param node     Pointer to timer node
+ * @param callback Called when the timer expires
+ * @param context  User data for the callback
+ */
+void softTimerWheel_initNode(softTimerNode_t *node,
+        softTimerCallback_t callback, void *context);
+
+/**
+ * @fn    void softTimerWheel_start(softTimerWheel_t*, softTimerNode_t*, uint32_t, uint32_t)
+ * @brief (Re)start a timer to expire timeout ticks after a given tick
+ * @param wheel   Pointer to timer wheel
+ * @param node    Pointer to timer node, restarted if already running
+ * @param now     Tick the timeout counts from
+ * @param timeout Timeout in ticks (SOFTTIMER_MS_TO_TICKS)
+ */
+void softTimerWheel_start(softTimerWheel_t *wheel, softTimerNode_t *node,
+        uint32_t now, uint32_t timeout);
+
+/**
+ * @fn    void softTimerWheel_stop(softTimerNode_t*)
+ * @brief Stop a timer, no-op if it is not running
+ * @param node Pointer to timer node
+ */
+void softTimerWheel_stop(softTimerNode_t *node);
+
+/**
+ * @fn    void softTimerWheel_process(softTimerWheel_t*, uint32_t)
+ * @brief Expire every timer due up to a given tick
+ * @param wheel Pointer to timer wheel
+ * @param now   Current tick, e.g. SOFTTIMER_TICK()
+ * @note  Each elapsed tick visits one slot, so the cost follows the due
+ *        timers and not the number of registered timers.
+ */
+void softTimerWheel_process(softTimerWheel_t *wheel, uint32_t now);
+
+/**
+ * @fn    bool softTimerWheel_nextDeadline(const softTimerWheel_t*, uint32_t*)
+ * @brief Find the earliest deadline of all running timers
+ * @param wheel    Pointer to timer wheel
+ * @param deadline Pointer to store the earliest deadline tick
+ * @return true if a timer is running, false if the wheel is empty
+ * @note  Walks every slot, meant to be called once before going to sleep.
+ */
+bool softTimerWheel_nextDeadline(const softTimerWheel_t *wheel,
+        uint32_t *deadline);
+
+/**
+ * @fn    static inline bool softTimerWheel_isRunning(const softTimerNode_t*)
+ * @brief Check if a wheel timer is running
+ * @param node Pointer to timer node
+ * @return true if the timer is registered in a wheel, false otherwise
+ */
+static inline bool softTimerWheel_isRunning(const softTimerNode_t *node)
+{
+    return (node->pprev != NULL);
+}
+
 #endif /* INC_SOFTTIMER_H_ */
 
 /************************ (C) COPYRIGHT KeyhanSalehi *****END OF FILE****/
@@ -0,0 +1,335 @@
+/**
+ ******************************************************************************
+ * @file           : button_bank.c
+ * @author         : KeyhanSalehi
+ * @brief          : Implementation of the Button Bank scanner.
+ ******************************************************************************
+ * @attention
+ *
+ * One IDR read per port and scan. With the mask engine a port's pins are
+ * debounced together: the raw pressed mask must stay unchanged for
+ * DEBOUNCE_DELAY_MS before it becomes the stable mask. With the vertical
+ * counter engine every pin is one lane of button_vcounter.h. In both cases
+ * newly pressed bits are counted through Button_RegisterPress.
+ *
+ ******************************************************************************
+ */
+
+/* Includes ------------------------------------------------------------------*/
+
+/* 1. System Header Files */
+
+/* 2. Project Header Files */
+
+/* 3. Module Header File */
+#include "button_bank.h"
+
+/* Defines & Macros ----------------------------------------------------------*/
+/**
+ * @brief Constants and macros specific to this file.
+ */
+
+/* Typedefs ------------------------------------------------------------------*/
+/**
+ * @brief Typedefs for local use in this file.
+ */
+
+/* Variables -----------------------------------------------------------------*/
+
+/* 1. Global Variables */
+
+/* 2. Static Variables */
+
+/* Function Declarations -----------------------------------------------------*/
+
+/* 1. Local Prototype Functions */
+
+/*! @fn @private */
+static void ButtonBank_Dispatch(ButtonBankPort_t *bankPort, uint16_t pressed,
+		uint16_t released, uint32_t tick);
+/*! @fn @private */
+static ButtonBankPort_t* ButtonBank_GetPort(ButtonBank_t *bank,
+		GPIO_TypeDef *port);
+/*! @fn @private */
+static ButtonBankPort_t* ButtonBank_AddLane(ButtonBank_t *bank,
+		GPIO_TypeDef *port, uint16_t pin, bool isActiveLow);
+/*! @fn @private */
+static uint8_t ButtonBank_PinBit(uint16_t pin);
+
+/* 2. Global Function Declarations */
+
+/*!
+ * @fn     void ButtonBank_Init(ButtonBank_t *bank).
+ * @brief  Initializes an empty bank.
+ * @param  bank Pointer to the ButtonBank_t structure.
+ * @return void
+ */
+void ButtonBank_Init(ButtonBank_t *bank) {
+	memset(bank, 0, sizeof(*bank));
+#if BUTTON_BANK_ENGINE == BUTTON_BANK_ENGINE_VCOUNTER
+	for (uint8_t i = 0; i < BUTTON_BANK_MAX_PORTS; i++) {
+		ButtonVCounter_init(&bank->ports[i].vcounter, 0U);
+	}
+	softTimer_reset(&bank->sampleTimer);
+#endif
+}
+
+/*!
+ * @fn     return_t ButtonBank_Add(ButtonBank_t *bank, Button_t *button).
+ * @brief  Moves an initialized button under the bank's scan.
+ * @param  bank Pointer to the ButtonBank_t structure.
+ * @param  button Pointer to a Button_t already set up by Button_Init.
+ * @return return_t Returns return_success or return_failed.
+ */
+return_t ButtonBank_Add(ButtonBank_t *bank, Button_t *button) {
+
+	/* Local variable & initial */
+	ButtonBankPort_t *bankPort = ButtonBank_AddLane(bank, BUTTON_PORT(button),
+			BUTTON_PIN(button), BUTTON_IS_ACTIVE_LOW(button));
+
+	if (bankPort == NULL) {
+		return return_failed;
+	}
+
+	bankPort->buttons[ButtonBank_PinBit(BUTTON_PIN(button))] = button;
+	button->source = BUTTON_SOURCE_EXTERNAL;
+	button->lastState = (GPIO_PinState) (BUTTON_ACTIVE_STATE(button) ^ GPIO_PIN_SET);
+
+	return return_success;
+}
+
+/*!
+ * @fn     return_t ButtonBank_AddPin(ButtonBank_t *bank, GPIO_TypeDef *port, uint16_t pin, uint32_t pull).
+ * @brief  Adds a pin debounced by the bank without a Button_t.
+ * @param  bank Pointer to the ButtonBank_t structure.
+ * @param  port GPIO port.
+ * @param  pin GPIO pin.
+ * @param  pull Pull configuration (GPIO_PULLUP, GPIO_PULLDOWN, or GPIO_NOPULL).
+ * @return return_t Returns return_success or return_failed.
+ */
+return_t ButtonBank_AddPin(ButtonBank_t *bank, GPIO_TypeDef *port,
+		uint16_t pin, uint32_t pull) {
+	return (ButtonBank_AddLane(bank, port, pin,
+			BUTTON_ACTIVE_STATE_OF(pull) == GPIO_PIN_RESET) != NULL) ?
+			return_success : return_failed;
+}
+
+/*!
+ * @fn     void ButtonBank_Scan(ButtonBank_t *bank).
+ * @brief  Reads every port once and feeds the debounced presses to buttons.
+ * @param  bank Pointer to the ButtonBank_t structure.
+ * @return void
+ */
+void ButtonBank_Scan(ButtonBank_t *bank) {
+	ButtonBank_ScanAt(bank, SOFTTIMER_TICK());
+}
+
+/*!
+ * @fn     void ButtonBank_ScanAt(ButtonBank_t *bank, uint32_t now).
+ * @brief  Same as ButtonBank_Scan, with the tick snapshot of the pass.
+ * @param  bank Pointer to the ButtonBank_t structure.
+ * @param  now Tick read once for the whole pass.
+ * @return void
+ */
+void ButtonBank_ScanAt(ButtonBank_t *bank, uint32_t now) {
+
+#if BUTTON_BANK_ENGINE == BUTTON_BANK_ENGINE_VCOUNTER
+	/* counters assume a fixed sample rate */
+	if (!softTimer_isElapsedAt(&bank->sampleTimer, now,
+			SOFTTIMER_MS_TO_TICKS(BUTTON_BANK_SAMPLE_MS))) {
+		return;
+	}
+	softTimer_resetAt(&bank->sampleTimer, now);
+#endif
+
+	for (uint8_t i = 0; i < bank->portCount; i++) {
+		/* one IDR read per port */
+		ButtonBank_Feed(&bank->ports[i], BUTTON_READ_PORT(bank->ports[i].port),
+				now);
+	}
+}
+
+/*!
+ * @fn     ButtonBankPort_t* ButtonBank_FindPort(ButtonBank_t *bank, GPIO_TypeDef *port).
+ * @brief  Finds the slot the bank uses for a port.
+ * @param  bank Pointer to the ButtonBank_t structure.
+ * @param  port GPIO port.
+ * @return ButtonBankPort_t* Port slot, or NULL when not found.
+ */
+ButtonBankPort_t* ButtonBank_FindPort(ButtonBank_t *bank, GPIO_TypeDef *port) {
+
+	for (uint8_t i = 0; i < bank->portCount; i++) {
+		if (bank->ports[i].port == port) {
+			return &bank->ports[i];
+		}
+	}
+
+	return NULL;
+}
+
+/*!
+ * @fn     void ButtonBank_Feed(ButtonBankPort_t *bankPort, uint16_t idr, uint32_t tick).
+ * @brief  Debounces one IDR sample of a port taken elsewhere (e.g. by DMA).
+ * @param  bankPort Pointer to the port slot (ButtonBank_FindPort).
+ * @param  idr Raw IDR value of the port.
+ * @param  tick Tick at which the sample was taken.
+ * @return void
+ */
+void ButtonBank_Feed(ButtonBankPort_t *bankPort, uint16_t idr, uint32_t tick) {
+
+	/* normalized so a set bit means pressed */
+	uint16_t raw = (uint16_t) ((idr ^ bankPort->activeLowMask)
+			& bankPort->pinMask);
+
+#if BUTTON_BANK_ENGINE == BUTTON_BANK_ENGINE_VCOUNTER
+	uint32_t toggled;
+
+	/* idle port: all lanes at their state, the update would only reload them */
+	if (raw == bankPort->vcounter.state) {
+		bankPort->vcounter.ct0 = 0xFFFFFFFFU;
+		bankPort->vcounter.ct1 = 0xFFFFFFFFU;
+		return;
+	}
+
+	toggled = ButtonVCounter_update(&bankPort->vcounter, raw);
+
+	ButtonBank_Dispatch(bankPort, (uint16_t) (toggled & bankPort->vcounter.state),
+			(uint16_t) (toggled & ~bankPort->vcounter.state), tick);
+#else
+	/* idle port: nothing changed since the last stable sample */
+	if (raw == bankPort->lastRaw && raw == bankPort->stable) {
+		return;
+	}
+
+	/* any change restarts the debounce window of the whole port */
+	if (raw != bankPort->lastRaw) {
+		bankPort->lastRaw = raw;
+		softTimer_resetAt(&bankPort->debounceTimer, tick);
+		return;
+	}
+
+	if (raw != bankPort->stable
+			&& softTimer_isElapsedAt(&bankPort->debounceTimer, tick,
+					SOFTTIMER_MS_TO_TICKS(DEBOUNCE_DELAY_MS))) {
+		uint16_t pressed = (uint16_t) (raw & ~bankPort->stable);
+		uint16_t released = (uint16_t) (~raw & bankPort->stable);
+
+		bankPort->stable = raw;
+		ButtonBank_Dispatch(bankPort, pressed, released, tick);
+	}
+#endif
+}
+
+/* 3. Local Function Declarations */
+
+/*!
+ * @fn     static void ButtonBank_Dispatch(ButtonBankPort_t *bankPort, uint16_t pressed, uint16_t released, uint32_t tick).
+ * @brief  Feeds the press or release of every set bit to its button.
+ * @param  bankPort Pointer to the port slot.
+ * @param  pressed Mask of the newly pressed pins.
+ * @param  released Mask of the newly released pins.
+ * @param  tick Tick of the scan.
+ * @return void
+ */
+static void ButtonBank_Dispatch(ButtonBankPort_t *bankPort, uint16_t pressed,
+		uint16_t released, uint32_t tick) {
+
+	for (uint8_t bit = 0; (pressed | released) != 0U;
+			bit++, pressed >>= 1, released >>= 1) {
+		/* pins added by ButtonBank_AddPin only live in the masks */
+		if (bankPort->buttons[bit] == NULL) {
+			continue;
+		}
+		if ((pressed & 1U) != 0U) {
+			uint16_t pin = (uint16_t) (1U << bit);
+
+			/* a chord decides whether its members report their presses */
+			if ((bankPort->chordMask & pin) == 0U) {
+				Button_RegisterPress(bankPort->buttons[bit], tick);
+			} else if (Button_CountPress(bankPort->buttons[bit], tick)) {
+				bankPort->deferredMask |= pin;
+			}
+		} else if ((released & 1U) != 0U) {
+			Button_RegisterRelease(bankPort->buttons[bit], tick);
+		}
+	}
+}
+
+/*!
+ * @fn     static ButtonBankPort_t* ButtonBank_GetPort(ButtonBank_t *bank, GPIO_TypeDef *port).
+ * @brief  Finds the slot of a port, or takes a free one.
+ * @param  bank Pointer to the ButtonBank_t structure.
+ * @param  port GPIO port.
+ * @return ButtonBankPort_t* Port slot, or NULL when the bank is full.
+ */
+static ButtonBankPort_t* ButtonBank_GetPort(ButtonBank_t *bank,
+		GPIO_TypeDef *port) {
+
+	/* Local variable & initial */
+	ButtonBankPort_t *bankPort = ButtonBank_FindPort(bank, port);
+
+	if (bankPort != NULL) {
+		return bankPort;
+	}
+
+	if (bank->portCount >= BUTTON_BANK_MAX_PORTS) {
+		return NULL;
+	}
+
+	bank->ports[bank->portCount].port = port;
+	return &bank->ports[bank->portCount++];
+}
+
+/*!
+ * @fn     static ButtonBankPort_t* ButtonBank_AddLane(ButtonBank_t *bank, GPIO_TypeDef *port, uint16_t pin, bool isActiveLow).
+ * @brief  Claims the lane of a pin in the slot of its port.
+ * @param  bank Pointer to the ButtonBank_t structure.
+ * @param  port GPIO port.
+ * @param  pin GPIO pin.
+ * @param  isActiveLow true if the pin is pressed when low.
+ * @return ButtonBankPort_t* Port slot, or NULL when the pin is not a single
+ *         pin, already used, or no port slot is left.
+ */
+static ButtonBankPort_t* ButtonBank_AddLane(ButtonBank_t *bank,
+		GPIO_TypeDef *port, uint16_t pin, bool isActiveLow) {
+
+	/* Local variable & initial */
+	ButtonBankPort_t *bankPort;
+
+	/* only single pin masks map to one bit lane */
+	if (pin == 0U || (pin & (pin - 1U)) != 0U) {
+		return NULL;
+	}
+
+	bankPort = ButtonBank_GetPort(bank, port);
+	if (bankPort == NULL || (bankPort->pinMask & pin) != 0U) {
+		return NULL;
+	}
+
+	bankPort->pinMask |= pin;
+	if (isActiveLow) {
+		bankPort->activeLowMask |= pin;
+	}
+
+	return bankPort;
+}
+
+/*!
+ * @fn     static uint8_t ButtonBank_PinBit(uint16_t pin).
+ * @brief  Gets the bit number of a single pin mask.
+ * @param  pin GPIO pin.
+ * @return uint8_t Bit number (0 for GPIO_PIN_0...).
+ */
+static uint8_t ButtonBank_PinBit(uint16_t pin) {
+
+	/* Local variable & initial */
+	uint8_t bit = 0;
+
+	while ((pin >> bit) != 1U) {
+		bit++;
+	}
+
+	return bit;
+}
+
+/************************ (C) COPYRIGHT [KeyhanSalehi] *****END OF FILE****/
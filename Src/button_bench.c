@@ -0,0 +1,378 @@
+/**
+ ******************************************************************************
+ * @file           : button_bench.c
+ * @author         : KeyhanSalehi
+ * @brief          : Implementation of the Button Handler cycle benchmark.
+ ******************************************************************************
+ * @attention
+ *
+ * Every case times one full pass over its button set (e.g. one
+ * Button_GetFinalCount per button) BUTTON_BENCH_ITERATIONS times. The cost
+ * of the two counter reads is measured once and taken off each pass.
+ *
+ * Idle cases leave the buttons released, so they mostly time the fast path.
+ * Active cases keep a sequence counting on every button, so the debounce,
+ * timeout and overflow code runs: polled buttons get a press fed before each
+ * pass that finds them idle, and bank ports are fed a click pattern on a
+ * simulated clock.
+ *
+ ******************************************************************************
+ */
+
+/* Includes ------------------------------------------------------------------*/
+
+/* 1. System Header Files */
+
+/* 2. Project Header Files */
+
+/* 3. Module Header File */
+#include "button_bench.h"
+
+#if BUTTON_BENCH_ENABLE
+
+/* Defines & Macros ----------------------------------------------------------*/
+/**
+ * @brief Constants and macros specific to this file.
+ */
+
+/*! @def @brief name of the bank engine in the report. */
+#if BUTTON_BANK_ENGINE == BUTTON_BANK_ENGINE_VCOUNTER
+#define BUTTON_BENCH_ENGINE "vcounter"
+#else
+#define BUTTON_BENCH_ENGINE "mask"
+#endif
+
+/*! @def @brief half period of the click pattern fed to the active bank case. */
+#define BUTTON_BENCH_CLICK_MS 100U
+
+/* Typedefs ------------------------------------------------------------------*/
+/**
+ * @brief Typedefs for local use in this file.
+ */
+
+/* Variables -----------------------------------------------------------------*/
+
+/* 1. Global Variables */
+
+/* 2. Static Variables */
+
+/*! @brief button sets of the cases, too large for the stack. */
+static Button_t benchButtons[BUTTON_BENCH_MAX_BUTTONS];
+static ButtonConfig_t benchConfigs[BUTTON_BENCH_MAX_BUTTONS];
+static ButtonBank_t benchBank;
+static ButtonResult_t benchResults[BUTTON_BENCH_MAX_BUTTONS];
+
+/*! @brief cycles taken by two back to back counter reads. */
+static uint32_t benchOverhead = 0;
+
+/*! @brief button counts measured. */
+static const uint8_t benchSizes[] = { 1U, 8U, 32U, 64U };
+
+/* Function Declarations -----------------------------------------------------*/
+
+/* 1. Local Prototype Functions */
+
+/*! @fn @private */
+static void ButtonBench_InitButton(uint8_t index, GPIO_TypeDef *port);
+/*! @fn @private */
+static void ButtonBench_Activate(uint8_t count);
+/*! @fn @private */
+static void ButtonBench_RunPoll(GPIO_TypeDef *const *ports, uint8_t portCount,
+		uint8_t count);
+/*! @fn @private */
+static void ButtonBench_RunBank(GPIO_TypeDef *const *ports, uint8_t count);
+
+/* 2. Global Function Declarations */
+
+/*!
+ * @fn     void ButtonBench_Init(void).
+ * @brief  Enables the DWT cycle counter and measures the read overhead.
+ * @return void
+ */
+void ButtonBench_Init(void) {
+
+	/* Local variable & initial */
+	ButtonBenchStats_t stats;
+
+	CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+#if defined(__CORTEX_M) && (__CORTEX_M == 7U)
+	DWT->LAR = 0xC5ACCE55U; /* unlock the DWT registers */
+#endif
+	DWT->CYCCNT = 0;
+	DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+	benchOverhead = 0;
+	ButtonBench_Reset(&stats);
+	for (uint32_t i = 0; i < 16U; i++) {
+		ButtonBench_Record(&stats, ButtonBench_Cycles());
+	}
+	benchOverhead = stats.min;
+}
+
+/*!
+ * @fn     void ButtonBench_Reset(ButtonBenchStats_t *stats).
+ * @brief  Clears the statistics of a case.
+ * @param  stats Pointer to the ButtonBenchStats_t structure.
+ * @return void
+ */
+void ButtonBench_Reset(ButtonBenchStats_t *stats) {
+	stats->min = UINT32_MAX;
+	stats->max = 0;
+	stats->total = 0;
+	stats->samples = 0;
+}
+
+/*!
+ * @fn     void ButtonBench_Record(ButtonBenchStats_t *stats, uint32_t start).
+ * @brief  Adds the cycles elapsed since start, less the read overhead.
+ * @param  stats Pointer to the ButtonBenchStats_t structure.
+ * @param  start ButtonBench_Cycles() taken before the measured code.
+ * @return void
+ */
+void ButtonBench_Record(ButtonBenchStats_t *stats, uint32_t start) {
+
+	/* Local variable & initial */
+	uint32_t cycles = ButtonBench_Cycles() - start;
+
+	cycles = (cycles > benchOverhead) ? cycles - benchOverhead : 0U;
+	if (cycles < stats->min) {
+		stats->min = cycles;
+	}
+	if (cycles > stats->max) {
+		stats->max = cycles;
+	}
+	stats->total += cycles;
+	stats->samples++;
+}
+
+/*!
+ * @fn     void ButtonBench_Print(const char *name, uint32_t buttons, const ButtonBenchStats_t *stats).
+ * @brief  Prints one line of the report.
+ * @param  name Name of the case.
+ * @param  buttons Number of buttons of the case.
+ * @param  stats Pointer to the ButtonBenchStats_t structure.
+ * @return void
+ */
+void ButtonBench_Print(const char *name, uint32_t buttons,
+		const ButtonBenchStats_t *stats) {
+
+	/* Local variable & initial */
+	uint32_t avg = (stats->samples == 0U) ?
+			0U : (uint32_t) (stats->total / stats->samples);
+
+	BUTTON_BENCH_PRINTF("%-16s n=%2lu min=%6lu avg=%6lu max=%6lu cycles (%lu/button)\r\n",
+			name, (unsigned long) buttons, (unsigned long) stats->min,
+			(unsigned long) avg, (unsigned long) stats->max,
+			(unsigned long) (avg / buttons));
+}
+
+/*!
+ * @fn     void ButtonBench_Run(GPIO_TypeDef *const *ports, uint8_t portCount).
+ * @brief  Measures and prints every case for 1, 8, 32 and 64 buttons.
+ * @param  ports GPIO ports the benchmark buttons are spread on (16 per port).
+ * @param  portCount Number of ports.
+ * @return void
+ */
+void ButtonBench_Run(GPIO_TypeDef *const *ports, uint8_t portCount) {
+
+	/* Local variable & initial */
+	uint32_t bankCapacity = (uint32_t) BUTTON_BANK_PORT_PINS
+			* ((portCount < BUTTON_BANK_MAX_PORTS) ? portCount : BUTTON_BANK_MAX_PORTS);
+
+	ButtonBench_Init();
+	BUTTON_BENCH_PRINTF("button_bench: %lu Hz, %s engine, %lu passes, overhead %lu cycles\r\n",
+			(unsigned long) SystemCoreClock, BUTTON_BENCH_ENGINE,
+			(unsigned long) BUTTON_BENCH_ITERATIONS, (unsigned long) benchOverhead);
+
+	for (uint8_t i = 0; i < sizeof(benchSizes); i++) {
+		ButtonBench_RunPoll(ports, portCount, benchSizes[i]);
+		if (benchSizes[i] <= bankCapacity) {
+			ButtonBench_RunBank(ports, benchSizes[i]);
+		} else {
+			BUTTON_BENCH_PRINTF("%-16s n=%2u skipped, not enough ports\r\n",
+					"bank", (unsigned) benchSizes[i]);
+		}
+	}
+}
+
+/* 3. Local Function Declarations */
+
+/*!
+ * @fn     static void ButtonBench_InitButton(uint8_t index, GPIO_TypeDef *port).
+ * @brief  Sets up benchmark button index on pin (index % 16) of a port.
+ * @param  index Index of the button.
+ * @param  port GPIO port of the button.
+ * @return void
+ * @note   Works with every layout, the configurations stay in RAM.
+ */
+static void ButtonBench_InitButton(uint8_t index, GPIO_TypeDef *port) {
+
+	/* Local variable & initial */
+	const ButtonConfig_t config = BUTTON_CONFIG_INIT(port,
+			(uint16_t) (1U << (index % BUTTON_BANK_PORT_PINS)), GPIO_PULLUP,
+			DEBOUNCE_DELAY_MS, BUTTON_TIMEOUT_MS, PUSH_COUNT_MAX);
+
+	benchConfigs[index] = config;
+	Button_InitConfig(&benchButtons[index], &benchConfigs[index]);
+}
+
+/*!
+ * @fn     static void ButtonBench_RunPoll(GPIO_TypeDef *const *ports, uint8_t portCount, uint8_t count).
+ * @brief  Times Button_GetFinalCount and Button_ProcessAll over a set of
+ *         polled buttons.
+ * @param  ports GPIO ports of the buttons.
+ * @param  portCount Number of ports.
+ * @param  count Number of buttons.
+ * @return void
+ */
+static void ButtonBench_RunPoll(GPIO_TypeDef *const *ports, uint8_t portCount,
+		uint8_t count) {
+
+	/* Local variable & initial */
+	ButtonBenchStats_t stats;
+	uint8_t keyVal = 0;
+
+	for (uint8_t i = 0; i < count; i++) {
+		ButtonBench_InitButton(i, ports[(i / BUTTON_BANK_PORT_PINS) % portCount]);
+	}
+
+	ButtonBench_Reset(&stats);
+	for (uint32_t pass = 0; pass < BUTTON_BENCH_ITERATIONS; pass++) {
+		uint32_t start = ButtonBench_Cycles();
+
+		for (uint8_t i = 0; i < count; i++) {
+			(void) Button_GetFinalCount(&benchButtons[i], &keyVal);
+		}
+		ButtonBench_Record(&stats, start);
+	}
+	ButtonBench_Print("GetFinalCount", count, &stats);
+
+	ButtonBench_Reset(&stats);
+	for (uint32_t pass = 0; pass < BUTTON_BENCH_ITERATIONS; pass++) {
+		uint32_t start = ButtonBench_Cycles();
+
+		(void) Button_ProcessAll(benchButtons, count, benchResults);
+		ButtonBench_Record(&stats, start);
+	}
+	ButtonBench_Print("ProcessAll", count, &stats);
+
+	ButtonBench_Reset(&stats);
+	for (uint32_t pass = 0; pass < BUTTON_BENCH_ITERATIONS; pass++) {
+		uint32_t start;
+
+		ButtonBench_Activate(count);
+		start = ButtonBench_Cycles();
+		for (uint8_t i = 0; i < count; i++) {
+			(void) Button_GetFinalCount(&benchButtons[i], &keyVal);
+		}
+		ButtonBench_Record(&stats, start);
+	}
+	ButtonBench_Print("GetFinalCount+", count, &stats);
+
+	ButtonBench_Reset(&stats);
+	for (uint32_t pass = 0; pass < BUTTON_BENCH_ITERATIONS; pass++) {
+		uint32_t start;
+
+		ButtonBench_Activate(count);
+		start = ButtonBench_Cycles();
+		(void) Button_ProcessAll(benchButtons, count, benchResults);
+		ButtonBench_Record(&stats, start);
+	}
+	ButtonBench_Print("ProcessAll+", count, &stats);
+}
+
+/*!
+ * @fn     static void ButtonBench_RunBank(GPIO_TypeDef *const *ports, uint8_t count).
+ * @brief  Times the bank scan and the polls of its buttons.
+ * @param  ports GPIO ports of the buttons.
+ * @param  count Number of buttons, at most 16 per port.
+ * @return void
+ */
+static void ButtonBench_RunBank(GPIO_TypeDef *const *ports, uint8_t count) {
+
+	/* Local variable & initial */
+	ButtonBenchStats_t scanStats;
+	ButtonBenchStats_t pollStats;
+	uint32_t tick = SOFTTIMER_TICK();
+	uint8_t keyVal = 0;
+
+	ButtonBank_Init(&benchBank);
+	for (uint8_t i = 0; i < count; i++) {
+		ButtonBench_InitButton(i, ports[i / BUTTON_BANK_PORT_PINS]);
+		(void) ButtonBank_Add(&benchBank, &benchButtons[i]);
+	}
+
+	ButtonBench_Reset(&scanStats);
+	ButtonBench_Reset(&pollStats);
+	for (uint32_t pass = 0; pass < BUTTON_BENCH_ITERATIONS; pass++) {
+		uint32_t start = ButtonBench_Cycles();
+
+		/* the scan without its sample pacing, so every pass does the work */
+		for (uint8_t p = 0; p < benchBank.portCount; p++) {
+			ButtonBank_Feed(&benchBank.ports[p],
+					BUTTON_READ_PORT(benchBank.ports[p].port), tick);
+		}
+		ButtonBench_Record(&scanStats, start);
+
+		start = ButtonBench_Cycles();
+		for (uint8_t i = 0; i < count; i++) {
+			(void) Button_GetFinalCount(&benchButtons[i], &keyVal);
+		}
+		ButtonBench_Record(&pollStats, start);
+	}
+	ButtonBench_Print("bank scan " BUTTON_BENCH_ENGINE, count, &scanStats);
+	ButtonBench_Print("bank poll", count, &pollStats);
+
+	/* every pin clicks, one sample per pass on a simulated clock */
+	ButtonBench_Reset(&scanStats);
+	ButtonBench_Reset(&pollStats);
+	for (uint32_t pass = 0; pass < BUTTON_BENCH_ITERATIONS; pass++) {
+		uint32_t start;
+		bool isPressed;
+
+		tick += SOFTTIMER_MS_TO_TICKS(BUTTON_BANK_SAMPLE_MS);
+		isPressed = ((tick / SOFTTIMER_MS_TO_TICKS(BUTTON_BENCH_CLICK_MS))
+				& 1U) != 0U;
+
+		start = ButtonBench_Cycles();
+		for (uint8_t p = 0; p < benchBank.portCount; p++) {
+			uint16_t activeLow = benchBank.ports[p].activeLowMask;
+
+			ButtonBank_Feed(&benchBank.ports[p],
+					isPressed ? (uint16_t) ~activeLow : activeLow, tick);
+		}
+		ButtonBench_Record(&scanStats, start);
+
+		start = ButtonBench_Cycles();
+		for (uint8_t i = 0; i < count; i++) {
+			(void) Button_GetFinalCountAt(&benchButtons[i], &keyVal, tick);
+		}
+		ButtonBench_Record(&pollStats, start);
+	}
+	ButtonBench_Print("bank scan+", count, &scanStats);
+	ButtonBench_Print("bank poll+", count, &pollStats);
+}
+
+/*!
+ * @fn     static void ButtonBench_Activate(uint8_t count).
+ * @brief  Opens a sequence on every benchmark button that has none.
+ * @param  count Number of buttons.
+ * @return void
+ * @note   Called outside the timed code. The press is fed like a bank scan
+ *         does, the next poll sees the released pin and counts on.
+ */
+static void ButtonBench_Activate(uint8_t count) {
+
+	/* Local variable & initial */
+	uint32_t tick = SOFTTIMER_TICK();
+
+	for (uint8_t i = 0; i < count; i++) {
+		if (Button_GetState(&benchButtons[i]) == BUTTON_STATE_IDLE) {
+			Button_RegisterPress(&benchButtons[i], tick);
+		}
+	}
+}
+
+#endif /* BUTTON_BENCH_ENABLE */
+
+/************************ (C) COPYRIGHT [KeyhanSalehi] *****END OF FILE****/
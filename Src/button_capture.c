@@ -0,0 +1,122 @@
+/**
+ ******************************************************************************
+ * @file           : button_capture.c
+ * @author         : KeyhanSalehi
+ * @brief          : Implementation of the TIM input-capture edge source.
+ ******************************************************************************
+ * @attention
+ *
+ * The tick of an edge is back-dated from the current tick by the counter
+ * ticks elapsed since the capture, so any counter width works and the
+ * interrupt latency does not show in the timestamps.
+ *
+ ******************************************************************************
+ */
+
+/* Includes ------------------------------------------------------------------*/
+
+/* 1. System Header Files */
+
+/* 2. Project Header Files */
+
+/* 3. Module Header File */
+#include "button_capture.h"
+
+#if BUTTON_CAPTURE_ENABLE
+
+/* Defines & Macros ----------------------------------------------------------*/
+/**
+ * @brief Constants and macros specific to this file.
+ */
+
+/*! @def @brief overcapture flag of a channel (TIM_CHANNEL_n is 4 * (n - 1)). */
+#define BUTTON_CAPTURE_OVERCAPTURE_FLAG(channel) \
+		((uint32_t) TIM_FLAG_CC1OF << ((channel) >> 2))
+
+/* Typedefs ------------------------------------------------------------------*/
+/**
+ * @brief Typedefs for local use in this file.
+ */
+
+/* Variables -----------------------------------------------------------------*/
+
+/* 1. Global Variables */
+
+/* 2. Static Variables */
+
+/* Function Declarations -----------------------------------------------------*/
+
+/* 1. Local Prototype Functions */
+
+/* 2. Global Function Declarations */
+
+/*!
+ * @fn     return_t ButtonCapture_Start(ButtonCapture_t *capture, Button_t *button, TIM_HandleTypeDef *htim, uint32_t channel).
+ * @brief  Switches a button to captured edges and starts the channel.
+ * @param  capture Pointer to the ButtonCapture_t structure.
+ * @param  button Pointer to an initialized Button_t.
+ * @param  htim Capture timer.
+ * @param  channel Capture channel.
+ * @return return_t Returns return_success or return_failed.
+ */
+return_t ButtonCapture_Start(ButtonCapture_t *capture, Button_t *button,
+		TIM_HandleTypeDef *htim, uint32_t channel) {
+
+	capture->button = button;
+	capture->htim = htim;
+	capture->channel = channel;
+
+	/* the edge queue takes over, starting from the real pin level */
+	Button_EnableEXTI(button);
+	capture->lastState = Button_ReadRaw(button);
+
+	if (HAL_TIM_IC_Start_IT(htim, channel) != HAL_OK) {
+		return return_failed;
+	}
+
+	return return_success;
+}
+
+/*!
+ * @fn     void ButtonCapture_Stop(ButtonCapture_t *capture).
+ * @brief  Stops the capture channel.
+ * @param  capture Pointer to the ButtonCapture_t structure.
+ * @return void
+ */
+void ButtonCapture_Stop(ButtonCapture_t *capture) {
+	(void) HAL_TIM_IC_Stop_IT(capture->htim, capture->channel);
+}
+
+/*!
+ * @fn     void ButtonCapture_Callback(ButtonCapture_t *capture).
+ * @brief  Queues the captured edge, call from the capture interrupt.
+ * @param  capture Pointer to the ButtonCapture_t structure.
+ * @return void
+ */
+void ButtonCapture_Callback(ButtonCapture_t *capture) {
+
+	/* Local variable & initial */
+	uint32_t now = SOFTTIMER_TICK();
+	uint32_t counter = __HAL_TIM_GET_COUNTER(capture->htim);
+	uint32_t captured = HAL_TIM_ReadCapturedValue(capture->htim,
+			capture->channel);
+	uint32_t age = (counter - captured) & BUTTON_CAPTURE_COUNTER_MASK;
+	uint32_t overcapture = BUTTON_CAPTURE_OVERCAPTURE_FLAG(capture->channel);
+
+	if (__HAL_TIM_GET_FLAG(capture->htim, overcapture)) {
+		/* edges were lost, the toggled level cannot be trusted */
+		__HAL_TIM_CLEAR_FLAG(capture->htim, overcapture);
+		capture->lastState = Button_ReadRaw(capture->button);
+	} else {
+		capture->lastState = (capture->lastState == GPIO_PIN_SET) ?
+				GPIO_PIN_RESET : GPIO_PIN_SET;
+	}
+
+	Button_QueueEdge(capture->button, now - age, capture->lastState);
+}
+
+/* 3. Local Function Declarations */
+
+#endif /* BUTTON_CAPTURE_ENABLE */
+
+/************************ (C) COPYRIGHT [KeyhanSalehi] *****END OF FILE****/
@@ -0,0 +1,221 @@
+/**
+ ******************************************************************************
+ * @file           : button_chord.c
+ * @author         : KeyhanSalehi
+ * @brief          : Implementation of the Button Chord detector.
+ ******************************************************************************
+ * @attention
+ *
+ * The first press on an idle port opens a window. When it ends, the pressed
+ * mask is compared with every chord; a match cancels the sequences of its
+ * members and latches them until all are released, so their releases and
+ * any re-press meanwhile are dropped as well. Presses after the window are
+ * plain button presses. Members count their presses as usual, but their
+ * first press (BUTTON_EVENT_PRESS, Button_GetPress) is only reported once
+ * the window ended without their chord.
+ *
+ ******************************************************************************
+ */
+
+/* Includes ------------------------------------------------------------------*/
+
+/* 1. System Header Files */
+
+/* 2. Project Header Files */
+#include "button_event.h"
+
+/* 3. Module Header File */
+#include "button_chord.h"
+
+/* Defines & Macros ----------------------------------------------------------*/
+/**
+ * @brief Constants and macros specific to this file.
+ */
+
+/* Typedefs ------------------------------------------------------------------*/
+/**
+ * @brief Typedefs for local use in this file.
+ */
+
+/* Variables -----------------------------------------------------------------*/
+
+/* 1. Global Variables */
+
+/* 2. Static Variables */
+
+/* Function Declarations -----------------------------------------------------*/
+
+/* 1. Local Prototype Functions */
+
+/*! @fn @private */
+static void ButtonChord_CancelMembers(ButtonChords_t *detector, uint16_t mask);
+/*! @fn @private */
+static void ButtonChord_ReportDeferred(ButtonChords_t *detector, uint32_t now);
+
+/* 2. Global Function Declarations */
+
+/*!
+ * @fn     void ButtonChord_Init(ButtonChords_t *detector, ButtonBankPort_t *bankPort, const ButtonChord_t *chords, size_t count).
+ * @brief  Initializes the chord detector of a bank port.
+ * @param  detector Pointer to the ButtonChords_t structure.
+ * @param  bankPort Pointer to the port slot.
+ * @param  chords Const table of the chords.
+ * @param  count Number of chords in the table.
+ * @return void
+ */
+void ButtonChord_Init(ButtonChords_t *detector, ButtonBankPort_t *bankPort,
+		const ButtonChord_t *chords, size_t count) {
+	memset(detector, 0, sizeof(*detector));
+	detector->chords = chords;
+	detector->count = count;
+	detector->bankPort = bankPort;
+	detector->lastPressed = ButtonBank_Pressed(bankPort);
+
+	/* members hold back their first press until the window decides */
+	for (size_t i = 0; i < count; i++) {
+		bankPort->chordMask |= chords[i].mask;
+	}
+}
+
+/*!
+ * @fn     void ButtonChord_Update(ButtonChords_t *detector).
+ * @brief  Resolves chords from the pressed mask of the last scan.
+ * @param  detector Pointer to the ButtonChords_t structure.
+ * @return void
+ */
+void ButtonChord_Update(ButtonChords_t *detector) {
+	ButtonChord_UpdateAt(detector, SOFTTIMER_TICK());
+}
+
+/*!
+ * @fn     void ButtonChord_UpdateAt(ButtonChords_t *detector, uint32_t now).
+ * @brief  Same as ButtonChord_Update, with the tick snapshot of the pass.
+ * @param  detector Pointer to the ButtonChords_t structure.
+ * @param  now Tick read once for the whole pass.
+ * @return void
+ */
+void ButtonChord_UpdateAt(ButtonChords_t *detector, uint32_t now) {
+
+	/* Local variable & initial */
+	uint16_t pressed = ButtonBank_Pressed(detector->bankPort);
+	uint16_t previous = detector->lastPressed;
+
+	detector->lastPressed = pressed;
+
+	/* members of a detected chord stay claimed until all are released */
+	if (detector->latched != 0U) {
+		ButtonChord_CancelMembers(detector, detector->latched);
+		detector->bankPort->deferredMask &= (uint16_t) ~detector->latched;
+		if ((pressed & detector->latched) == 0U) {
+			detector->latched = 0;
+		}
+		ButtonChord_ReportDeferred(detector, now);
+		return;
+	}
+
+	if (previous == 0U && pressed != 0U) {
+		detector->isWindowOpen = true;
+		softTimer_resetAt(&detector->windowTimer, now);
+	}
+
+	if (!detector->isWindowOpen) {
+		/* presses outside a window belong to no chord */
+		ButtonChord_ReportDeferred(detector, now);
+		return;
+	}
+	if (!softTimer_isElapsedAt(&detector->windowTimer, now,
+			SOFTTIMER_MS_TO_TICKS(BUTTON_CHORD_WINDOW_MS))) {
+		return;
+	}
+	detector->isWindowOpen = false;
+
+	for (size_t i = 0; i < detector->count; i++) {
+		const ButtonChord_t *chord = &detector->chords[i];
+
+		if (pressed == chord->mask) {
+			ButtonEventQueue_t *queue = Button_GetEventQueue();
+
+			ButtonChord_CancelMembers(detector, chord->mask);
+			detector->bankPort->deferredMask &= (uint16_t) ~chord->mask;
+			detector->latched = chord->mask;
+			detector->pendingId = chord->id;
+			detector->isPending = true;
+
+			if (queue != NULL) {
+				ButtonEvent_t event = {
+						.timestamp = now,
+						.duration = 0U,
+						.id = chord->id,
+						.type = (uint8_t) BUTTON_EVENT_CHORD,
+						.count = 1U };
+
+				(void) ButtonEvent_Push(queue, &event);
+			}
+			break;
+		}
+	}
+
+	/* no chord, or presses that are not part of it */
+	ButtonChord_ReportDeferred(detector, now);
+}
+
+/*!
+ * @fn     return_t ButtonChord_Get(ButtonChords_t *detector, uint8_t *id).
+ * @brief  Reports a detected chord once.
+ * @param  detector Pointer to the ButtonChords_t structure.
+ * @param  id Pointer to store the chord id.
+ * @return return_t Returns return_success or return_busy.
+ */
+return_t ButtonChord_Get(ButtonChords_t *detector, uint8_t *id) {
+	if (detector->isPending) {
+		*id = detector->pendingId;
+		detector->isPending = false;
+		return return_success;
+	}
+
+	return return_busy;
+}
+
+/* 3. Local Function Declarations */
+
+/*!
+ * @fn     static void ButtonChord_CancelMembers(ButtonChords_t *detector, uint16_t mask).
+ * @brief  Drops the sequences of the buttons of a mask.
+ * @param  detector Pointer to the ButtonChords_t structure.
+ * @param  mask Pins of the buttons.
+ * @return void
+ */
+static void ButtonChord_CancelMembers(ButtonChords_t *detector, uint16_t mask) {
+
+	for (uint8_t bit = 0; mask != 0U; bit++, mask >>= 1) {
+		if ((mask & 1U) != 0U && detector->bankPort->buttons[bit] != NULL) {
+			Button_Cancel(detector->bankPort->buttons[bit]);
+		}
+	}
+}
+
+/*!
+ * @fn     static void ButtonChord_ReportDeferred(ButtonChords_t *detector, uint32_t now).
+ * @brief  Reports the first presses the members held back.
+ * @param  detector Pointer to the ButtonChords_t structure.
+ * @param  now Tick of the pass, the time the presses are reported at.
+ * @return void
+ */
+static void ButtonChord_ReportDeferred(ButtonChords_t *detector, uint32_t now) {
+
+	/* Local variable & initial */
+	ButtonBankPort_t *bankPort = detector->bankPort;
+	uint16_t mask = bankPort->deferredMask;
+
+	bankPort->deferredMask = 0;
+	for (uint8_t bit = 0; mask != 0U; bit++, mask >>= 1) {
+		Button_t *button = bankPort->buttons[bit];
+
+		/* a sequence dropped meanwhile has no press left to report */
+		if ((mask & 1U) != 0U && button != NULL && button->pushCount > 0U) {
+			Button_ReportPress(button, now);
+		}
+	}
+}
+
+/************************ (C) COPYRIGHT [KeyhanSalehi] *****END OF FILE****/
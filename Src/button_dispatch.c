@@ -0,0 +1,140 @@
+/**
+ ******************************************************************************
+ * @file           : button_dispatch.c
+ * @author         : KeyhanSalehi
+ * @brief          : Implementation of the Button Event dispatcher.
+ ******************************************************************************
+ * @attention
+ *
+ * The tables are const and indexed directly, so a dispatch is two bounds
+ * checks and two loads, with no search over the buttons or the counts.
+ *
+ ******************************************************************************
+ */
+
+/* Includes ------------------------------------------------------------------*/
+
+/* 1. System Header Files */
+
+/* 2. Project Header Files */
+
+/* 3. Module Header File */
+#include "button_dispatch.h"
+
+/* Defines & Macros ----------------------------------------------------------*/
+/**
+ * @brief Constants and macros specific to this file.
+ */
+
+/* Typedefs ------------------------------------------------------------------*/
+/**
+ * @brief Typedefs for local use in this file.
+ */
+
+/* Variables -----------------------------------------------------------------*/
+
+/* 1. Global Variables */
+
+/* 2. Static Variables */
+
+/* Function Declarations -----------------------------------------------------*/
+
+/* 1. Local Prototype Functions */
+
+/* 2. Global Function Declarations */
+
+/*!
+ * @fn     void ButtonDispatch_Init(ButtonDispatch_t *dispatch, ButtonEventQueue_t *queue, const ButtonCallbacks_t *const *tables, size_t count).
+ * @brief  Initializes a dispatcher.
+ * @param  dispatch Pointer to the ButtonDispatch_t structure.
+ * @param  queue Pointer to the event queue.
+ * @param  tables Callback tables indexed by button id.
+ * @param  count Number of tables.
+ * @return void
+ */
+void ButtonDispatch_Init(ButtonDispatch_t *dispatch, ButtonEventQueue_t *queue,
+		const ButtonCallbacks_t *const *tables, size_t count) {
+	dispatch->queue = queue;
+	dispatch->tables = tables;
+	dispatch->count = count;
+	dispatch->unhandled = 0;
+}
+
+/*!
+ * @fn     return_t ButtonDispatch_Event(ButtonDispatch_t *dispatch, const ButtonEvent_t *event).
+ * @brief  Calls the callback of one event.
+ * @param  dispatch Pointer to the ButtonDispatch_t structure.
+ * @param  event Event to dispatch.
+ * @return return_t Returns return_success or return_failed.
+ */
+return_t ButtonDispatch_Event(ButtonDispatch_t *dispatch,
+		const ButtonEvent_t *event) {
+
+	/* Local variable & initial */
+	const ButtonCallbacks_t *table = NULL;
+	ButtonCallback_t callback = NULL;
+
+	if (event->id < dispatch->count) {
+		table = dispatch->tables[event->id];
+	}
+
+	if (table != NULL) {
+		if (event->type == (uint8_t) BUTTON_EVENT_CLICKS
+				&& event->count < BUTTON_DISPATCH_CLICKS) {
+			callback = table->onClicks[event->count];
+		}
+		if (callback == NULL && event->type < (uint8_t) BUTTON_EVENT_TYPE_COUNT) {
+			callback = table->onEvent[event->type];
+		}
+	}
+
+	if (callback == NULL) {
+		dispatch->unhandled++;
+		return return_failed;
+	}
+
+	callback(event);
+	return return_success;
+}
+
+/*!
+ * @fn     size_t ButtonDispatch_Run(ButtonDispatch_t *dispatch).
+ * @brief  Drains the queue and dispatches every event.
+ * @param  dispatch Pointer to the ButtonDispatch_t structure.
+ * @return size_t Number of events taken from the queue.
+ */
+size_t ButtonDispatch_Run(ButtonDispatch_t *dispatch) {
+
+	/* Local variable & initial */
+	ButtonEvent_t events[BUTTON_DISPATCH_BATCH];
+	size_t total = 0;
+	size_t count;
+
+	while ((count = ButtonEvent_PopBatch(dispatch->queue, events,
+			BUTTON_DISPATCH_BATCH)) != 0U) {
+		for (size_t i = 0; i < count; i++) {
+			(void) ButtonDispatch_Event(dispatch, &events[i]);
+		}
+		total += count;
+	}
+
+	return total;
+}
+
+#if BUTTON_DISPATCH_DEFER
+/*!
+ * @fn     void ButtonDispatch_Request(const ButtonDispatch_t *dispatch).
+ * @brief  Pends the dispatch interrupt when events are waiting.
+ * @param  dispatch Pointer to the ButtonDispatch_t structure.
+ * @return void
+ */
+void ButtonDispatch_Request(const ButtonDispatch_t *dispatch) {
+	if (dispatch->queue->head != dispatch->queue->tail) {
+		BUTTON_DISPATCH_PEND();
+	}
+}
+#endif
+
+/* 3. Local Function Declarations */
+
+/************************ (C) COPYRIGHT [KeyhanSalehi] *****END OF FILE****/
@@ -0,0 +1,211 @@
+/**
+ ******************************************************************************
+ * @file           : button_dma.c
+ * @author         : KeyhanSalehi
+ * @brief          : Implementation of the DMA sampler of the Button Bank.
+ ******************************************************************************
+ * @attention
+ *
+ * The timer update event moves GPIOx->IDR to the next buffer entry. The
+ * half-transfer interrupt hands the first half to ButtonBank_Feed while the
+ * DMA fills the second one, the transfer-complete interrupt the second
+ * half. Each half is re-anchored to the current tick, its last sample
+ * having just been taken, and the earlier samples are back-dated by the
+ * fixed sample period, so debounce timing neither depends on interrupt
+ * latency nor drifts ahead of the ticks the timeout checks use.
+ *
+ ******************************************************************************
+ */
+
+/* Includes ------------------------------------------------------------------*/
+
+/* 1. System Header Files */
+
+/* 2. Project Header Files */
+
+/* 3. Module Header File */
+#include "button_dma.h"
+
+#if BUTTON_DMA_ENABLE
+
+/* Defines & Macros ----------------------------------------------------------*/
+/**
+ * @brief Constants and macros specific to this file.
+ */
+
+/*! @def @brief samples processed per interrupt. */
+#define BUTTON_DMA_HALF_SIZE (BUTTON_DMA_BUFFER_SIZE / 2U)
+
+/* Typedefs ------------------------------------------------------------------*/
+/**
+ * @brief Typedefs for local use in this file.
+ */
+
+/* Variables -----------------------------------------------------------------*/
+
+/* 1. Global Variables */
+
+/* 2. Static Variables */
+
+/*! @brief started samplers, looked up by their DMA handle. */
+static ButtonDma_t *buttonDmaStreams[BUTTON_DMA_MAX_STREAMS];
+
+/* Function Declarations -----------------------------------------------------*/
+
+/* 1. Local Prototype Functions */
+
+/*! @fn @private */
+static void ButtonDma_ProcessHalf(DMA_HandleTypeDef *hdma, uint32_t offset);
+/*! @fn @private */
+static void ButtonDma_HalfCpltCallback(DMA_HandleTypeDef *hdma);
+/*! @fn @private */
+static void ButtonDma_CpltCallback(DMA_HandleTypeDef *hdma);
+
+/* 2. Global Function Declarations */
+
+/*!
+ * @fn     return_t ButtonDma_Init(ButtonDma_t *dma, ButtonBank_t *bank, GPIO_TypeDef *port).
+ * @brief  Binds a sampler to the port slot of a bank.
+ * @param  dma Pointer to the ButtonDma_t structure.
+ * @param  bank Pointer to the ButtonBank_t structure.
+ * @param  port GPIO port to sample.
+ * @return return_t Returns return_success or return_failed.
+ */
+return_t ButtonDma_Init(ButtonDma_t *dma, ButtonBank_t *bank,
+		GPIO_TypeDef *port) {
+	memset(dma, 0, sizeof(*dma));
+	dma->bankPort = ButtonBank_FindPort(bank, port);
+
+	return (dma->bankPort != NULL) ? return_success : return_failed;
+}
+
+/*!
+ * @fn     return_t ButtonDma_Start(ButtonDma_t *dma, TIM_HandleTypeDef *htim).
+ * @brief  Starts the timer-triggered DMA reads of the port's IDR.
+ * @param  dma Pointer to the ButtonDma_t structure.
+ * @param  htim Timer whose update event has a DMA stream linked in CubeMx.
+ * @return return_t Returns return_success or return_failed.
+ */
+return_t ButtonDma_Start(ButtonDma_t *dma, TIM_HandleTypeDef *htim) {
+
+	/* Local variable & initial */
+	DMA_HandleTypeDef *hdma = htim->hdma[TIM_DMA_ID_UPDATE];
+	uint8_t slot = 0;
+
+	if (dma->bankPort == NULL || hdma == NULL) {
+		return return_failed;
+	}
+	while (slot < BUTTON_DMA_MAX_STREAMS && buttonDmaStreams[slot] != NULL) {
+		slot++;
+	}
+	if (slot == BUTTON_DMA_MAX_STREAMS) {
+		return return_failed;
+	}
+
+	dma->htim = htim;
+	dma->hdma = hdma;
+	dma->sampleTick = SOFTTIMER_TICK();
+	buttonDmaStreams[slot] = dma;
+
+	/* both callbacks set, so HAL_DMA_Start_IT enables the half-transfer irq */
+	hdma->XferHalfCpltCallback = ButtonDma_HalfCpltCallback;
+	hdma->XferCpltCallback = ButtonDma_CpltCallback;
+	if (HAL_DMA_Start_IT(hdma, (uint32_t) (uintptr_t) &dma->bankPort->port->IDR,
+			(uint32_t) (uintptr_t) dma->samples, BUTTON_DMA_BUFFER_SIZE) != HAL_OK) {
+		buttonDmaStreams[slot] = NULL;
+		return return_failed;
+	}
+	__HAL_TIM_ENABLE_DMA(htim, TIM_DMA_UPDATE);
+	if (HAL_TIM_Base_Start(htim) != HAL_OK) {
+		ButtonDma_Stop(dma);
+		return return_failed;
+	}
+
+	return return_success;
+}
+
+/*!
+ * @fn     void ButtonDma_Stop(ButtonDma_t *dma).
+ * @brief  Stops the timer and the DMA of a started sampler.
+ * @param  dma Pointer to the ButtonDma_t structure.
+ * @return void
+ */
+void ButtonDma_Stop(ButtonDma_t *dma) {
+	if (dma->hdma == NULL) {
+		return;
+	}
+
+	(void) HAL_TIM_Base_Stop(dma->htim);
+	__HAL_TIM_DISABLE_DMA(dma->htim, TIM_DMA_UPDATE);
+	(void) HAL_DMA_Abort(dma->hdma);
+
+	for (uint8_t slot = 0; slot < BUTTON_DMA_MAX_STREAMS; slot++) {
+		if (buttonDmaStreams[slot] == dma) {
+			buttonDmaStreams[slot] = NULL;
+		}
+	}
+	dma->hdma = NULL;
+}
+
+/* 3. Local Function Declarations */
+
+/*!
+ * @fn     static void ButtonDma_ProcessHalf(DMA_HandleTypeDef *hdma, uint32_t offset).
+ * @brief  Feeds one half of the circular buffer to the bank.
+ * @param  hdma DMA handle that raised the interrupt.
+ * @param  offset Index of the first sample of the half.
+ * @return void
+ */
+static void ButtonDma_ProcessHalf(DMA_HandleTypeDef *hdma, uint32_t offset) {
+
+	/* Local variable & initial */
+	ButtonDma_t *dma = NULL;
+	uint32_t now = SOFTTIMER_TICK();
+	uint32_t period = SOFTTIMER_MS_TO_TICKS(BUTTON_DMA_SAMPLE_MS);
+
+	for (uint8_t slot = 0; slot < BUTTON_DMA_MAX_STREAMS; slot++) {
+		if (buttonDmaStreams[slot] != NULL && buttonDmaStreams[slot]->hdma == hdma) {
+			dma = buttonDmaStreams[slot];
+			break;
+		}
+	}
+	if (dma == NULL) {
+		return;
+	}
+
+	/* the DMA is writing the other half meanwhile */
+	for (uint32_t i = 0; i < BUTTON_DMA_HALF_SIZE; i++) {
+		uint32_t tick = now - (BUTTON_DMA_HALF_SIZE - 1U - i) * period;
+
+		/* a late previous half must not make the ticks go backwards */
+		if ((int32_t) (tick - dma->sampleTick) < 0) {
+			tick = dma->sampleTick;
+		}
+		dma->sampleTick = tick;
+		ButtonBank_Feed(dma->bankPort, dma->samples[offset + i], tick);
+	}
+}
+
+/*!
+ * @fn     static void ButtonDma_HalfCpltCallback(DMA_HandleTypeDef *hdma).
+ * @brief  Half-transfer interrupt, the first half is ready.
+ * @param  hdma DMA handle.
+ * @return void
+ */
+static void ButtonDma_HalfCpltCallback(DMA_HandleTypeDef *hdma) {
+	ButtonDma_ProcessHalf(hdma, 0U);
+}
+
+/*!
+ * @fn     static void ButtonDma_CpltCallback(DMA_HandleTypeDef *hdma).
+ * @brief  Transfer-complete interrupt, the second half is ready.
+ * @param  hdma DMA handle.
+ * @return void
+ */
+static void ButtonDma_CpltCallback(DMA_HandleTypeDef *hdma) {
+	ButtonDma_ProcessHalf(hdma, BUTTON_DMA_HALF_SIZE);
+}
+
+#endif /* BUTTON_DMA_ENABLE */
+
+/************************ (C) COPYRIGHT [KeyhanSalehi] *****END OF FILE****/
@@ -0,0 +1,206 @@
+/**
+ ******************************************************************************
+ * @file           : button_encoder.c
+ * @author         : KeyhanSalehi
+ * @brief          : Implementation of the Rotary Encoder decoder.
+ ******************************************************************************
+ * @attention
+ *
+ * The previous and current A/B levels index a 16-entry table giving +1, -1
+ * or 0 quadrature steps, so contact bounce on one channel only moves back
+ * and forth and an impossible double change is ignored. In timer mode the
+ * hardware counter does the decoding and the 16-bit difference since the
+ * previous update gives the steps. Steps are then gathered into detents.
+ *
+ ******************************************************************************
+ */
+
+/* Includes ------------------------------------------------------------------*/
+
+/* 1. System Header Files */
+
+/* 2. Project Header Files */
+#include "button_event.h"
+
+/* 3. Module Header File */
+#include "button_encoder.h"
+
+/* Defines & Macros ----------------------------------------------------------*/
+/**
+ * @brief Constants and macros specific to this file.
+ */
+
+/* Typedefs ------------------------------------------------------------------*/
+/**
+ * @brief Typedefs for local use in this file.
+ */
+
+/* Variables -----------------------------------------------------------------*/
+
+/* 1. Global Variables */
+
+/* 2. Static Variables */
+
+/*! @brief steps of a transition, indexed by (previous AB << 2) | current AB. */
+static const int8_t encoderSteps[16] = {
+		0, -1, 1, 0,
+		1, 0, 0, -1,
+		-1, 0, 0, 1,
+		0, 1, -1, 0 };
+
+/* Function Declarations -----------------------------------------------------*/
+
+/* 1. Local Prototype Functions */
+
+/*! @fn @private */
+static uint8_t ButtonEncoder_ReadState(const ButtonEncoder_t *encoder);
+
+/* 2. Global Function Declarations */
+
+/*!
+ * @fn     void ButtonEncoder_Init(ButtonEncoder_t *encoder, GPIO_TypeDef *portA, uint16_t pinA, GPIO_TypeDef *portB, uint16_t pinB).
+ * @brief  Initializes an encoder decoded from its GPIO pins.
+ * @param  encoder Pointer to the ButtonEncoder_t structure.
+ * @param  portA GPIO port of channel A.
+ * @param  pinA GPIO pin of channel A.
+ * @param  portB GPIO port of channel B.
+ * @param  pinB GPIO pin of channel B.
+ * @return void
+ */
+void ButtonEncoder_Init(ButtonEncoder_t *encoder, GPIO_TypeDef *portA,
+		uint16_t pinA, GPIO_TypeDef *portB, uint16_t pinB) {
+	memset(encoder, 0, sizeof(*encoder));
+	encoder->portA = portA;
+	encoder->pinA = pinA;
+	encoder->portB = portB;
+	encoder->pinB = pinB;
+	encoder->state = ButtonEncoder_ReadState(encoder);
+}
+
+#if BUTTON_ENCODER_TIM_ENABLE
+/*!
+ * @fn     return_t ButtonEncoder_InitTim(ButtonEncoder_t *encoder, TIM_HandleTypeDef *htim).
+ * @brief  Initializes an encoder counted by a timer in encoder mode.
+ * @param  encoder Pointer to the ButtonEncoder_t structure.
+ * @param  htim Timer configured in TIM_ENCODERMODE_TI12.
+ * @return return_t Returns return_success or return_failed.
+ */
+return_t ButtonEncoder_InitTim(ButtonEncoder_t *encoder,
+		TIM_HandleTypeDef *htim) {
+	memset(encoder, 0, sizeof(*encoder));
+	encoder->htim = htim;
+
+	if (HAL_TIM_Encoder_Start(htim, TIM_CHANNEL_ALL) != HAL_OK) {
+		return return_failed;
+	}
+	encoder->lastCount = (uint16_t) __HAL_TIM_GET_COUNTER(htim);
+
+	return return_success;
+}
+#endif
+
+/*!
+ * @fn     void ButtonEncoder_SetId(ButtonEncoder_t *encoder, uint8_t id).
+ * @brief  Sets the id the encoder reports in its events.
+ * @param  encoder Pointer to the ButtonEncoder_t structure.
+ * @param  id Encoder id.
+ * @return void
+ */
+void ButtonEncoder_SetId(ButtonEncoder_t *encoder, uint8_t id) {
+	encoder->id = id;
+}
+
+/*!
+ * @fn     void ButtonEncoder_SetEventQueue(ButtonEncoder_t *encoder, ButtonEventQueue_t *queue).
+ * @brief  Sets the queue the encoder publishes its rotation events to.
+ * @param  encoder Pointer to the ButtonEncoder_t structure.
+ * @param  queue Pointer to an initialized ButtonEventQueue_t, or NULL.
+ * @return void
+ */
+void ButtonEncoder_SetEventQueue(ButtonEncoder_t *encoder,
+		ButtonEventQueue_t *queue) {
+	encoder->queue = queue;
+}
+
+/*!
+ * @fn     int32_t ButtonEncoder_Update(ButtonEncoder_t *encoder).
+ * @brief  Decodes the encoder and publishes the detents turned.
+ * @param  encoder Pointer to the ButtonEncoder_t structure.
+ * @return int32_t Detents turned since the previous update, clockwise positive.
+ */
+int32_t ButtonEncoder_Update(ButtonEncoder_t *encoder) {
+
+	/* Local variable & initial */
+	int32_t steps = encoder->steps;
+	int32_t detents;
+	ButtonEventQueue_t *queue = encoder->queue;
+
+#if BUTTON_ENCODER_TIM_ENABLE
+	if (encoder->htim != NULL) {
+		uint16_t count = (uint16_t) __HAL_TIM_GET_COUNTER(encoder->htim);
+
+		/* 16-bit difference survives the counter wrap */
+		steps += (int16_t) (uint16_t) (count - encoder->lastCount);
+		encoder->lastCount = count;
+	} else
+#endif
+	{
+		uint8_t state = ButtonEncoder_ReadState(encoder);
+
+		steps += encoderSteps[(encoder->state << 2) | state];
+		encoder->state = state;
+	}
+
+	/* truncates toward zero, the remainder waits for the next update */
+	detents = steps / BUTTON_ENCODER_STEPS_PER_DETENT;
+	encoder->steps = (int16_t) (steps - detents * BUTTON_ENCODER_STEPS_PER_DETENT);
+	encoder->position += detents;
+
+	if (detents != 0 && queue != NULL) {
+		uint32_t magnitude = (uint32_t) ((detents < 0) ? -detents : detents);
+		ButtonEvent_t event = {
+				.timestamp = SOFTTIMER_TICK(),
+				.duration = 0U,
+				.id = encoder->id,
+				.type = (uint8_t) ((detents > 0) ?
+						BUTTON_EVENT_ROTATE_CW : BUTTON_EVENT_ROTATE_CCW),
+				.count = (magnitude > UINT8_MAX) ? UINT8_MAX : (uint8_t) magnitude };
+
+		(void) ButtonEvent_Push(queue, &event);
+	}
+
+	return detents;
+}
+
+/*!
+ * @fn     int32_t ButtonEncoder_GetPosition(const ButtonEncoder_t *encoder).
+ * @brief  Gets the detents turned since init.
+ * @param  encoder Pointer to the ButtonEncoder_t structure.
+ * @return int32_t Position in detents, clockwise positive.
+ */
+int32_t ButtonEncoder_GetPosition(const ButtonEncoder_t *encoder) {
+	return encoder->position;
+}
+
+/* 3. Local Function Declarations */
+
+/*!
+ * @fn     static uint8_t ButtonEncoder_ReadState(const ButtonEncoder_t *encoder).
+ * @brief  Reads the A/B levels of a GPIO encoder.
+ * @param  encoder Pointer to the ButtonEncoder_t structure.
+ * @return uint8_t A level in bit 1, B level in bit 0 (0 in timer mode).
+ */
+static uint8_t ButtonEncoder_ReadState(const ButtonEncoder_t *encoder) {
+
+	if (encoder->portA == NULL) {
+		return 0U;
+	}
+
+	return (uint8_t) (
+			((BUTTON_READ_PIN(encoder->portA, encoder->pinA) == GPIO_PIN_SET) ?
+					2U : 0U)
+					| ((BUTTON_READ_PIN(encoder->portB, encoder->pinB)
+							== GPIO_PIN_SET) ? 1U : 0U));
+}
+
+/************************ (C) COPYRIGHT [KeyhanSalehi] *****END OF FILE****/
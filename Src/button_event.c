@@ -0,0 +1,141 @@
+/**
+ ******************************************************************************
+ * @file           : button_event.c
+ * @author         : KeyhanSalehi
+ * @brief          : Implementation of the Button Event queue.
+ ******************************************************************************
+ * @attention
+ *
+ * head and tail are free-running counters, each written by one side only,
+ * so no critical section is needed. A barrier orders the event copy before
+ * the counter that publishes (or releases) its slot.
+ *
+ ******************************************************************************
+ */
+
+/* Includes ------------------------------------------------------------------*/
+
+/* 1. System Header Files */
+
+/* 2. Project Header Files */
+
+/* 3. Module Header File */
+#include "button_event.h"
+
+/* Defines & Macros ----------------------------------------------------------*/
+/**
+ * @brief Constants and macros specific to this file.
+ */
+
+/*! @def @brief slot of a free-running counter. */
+#define BUTTON_EVENT_SLOT(counter) ((counter) & (BUTTON_EVENT_QUEUE_SIZE - 1U))
+
+/* Typedefs ------------------------------------------------------------------*/
+/**
+ * @brief Typedefs for local use in this file.
+ */
+
+/* Variables -----------------------------------------------------------------*/
+
+/* 1. Global Variables */
+
+/* 2. Static Variables */
+
+/* Function Declarations -----------------------------------------------------*/
+
+/* 1. Local Prototype Functions */
+
+/* 2. Global Function Declarations */
+
+/*!
+ * @fn     void ButtonEvent_Init(ButtonEventQueue_t *queue).
+ * @brief  Initializes an empty event queue.
+ * @param  queue Pointer to the ButtonEventQueue_t structure.
+ * @return void
+ */
+void ButtonEvent_Init(ButtonEventQueue_t *queue) {
+	queue->head = 0;
+	queue->tail = 0;
+	queue->dropped = 0;
+#if BUTTON_EVENT_CHECK_PRODUCER
+	queue->producer = BUTTON_EVENT_NO_PRODUCER;
+	queue->wrongContext = 0;
+#endif
+}
+
+/*!
+ * @fn     return_t ButtonEvent_Push(ButtonEventQueue_t *queue, const ButtonEvent_t *event).
+ * @brief  Appends an event, producer side only.
+ * @param  queue Pointer to the ButtonEventQueue_t structure.
+ * @param  event Event to copy into the queue.
+ * @return return_t Returns return_success or return_failed.
+ */
+return_t ButtonEvent_Push(ButtonEventQueue_t *queue, const ButtonEvent_t *event) {
+
+	/* Local variable & initial */
+	uint32_t head = queue->head;
+
+#if BUTTON_EVENT_CHECK_PRODUCER
+	/* the first push binds the queue to its producer context */
+	if (queue->producer == BUTTON_EVENT_NO_PRODUCER) {
+		queue->producer = BUTTON_EVENT_CONTEXT();
+	} else if (queue->producer != BUTTON_EVENT_CONTEXT()) {
+		queue->wrongContext++;
+		return return_failed;
+	}
+#endif
+
+	if ((uint32_t) (head - queue->tail) >= BUTTON_EVENT_QUEUE_SIZE) {
+		queue->dropped++;
+		return return_failed;
+	}
+
+	queue->events[BUTTON_EVENT_SLOT(head)] = *event;
+	BUTTON_EVENT_BARRIER(); /* event visible before it is published */
+	queue->head = head + 1U;
+
+	return return_success;
+}
+
+/*!
+ * @fn     return_t ButtonEvent_Pop(ButtonEventQueue_t *queue, ButtonEvent_t *event).
+ * @brief  Takes the oldest event, consumer side only.
+ * @param  queue Pointer to the ButtonEventQueue_t structure.
+ * @param  event Pointer to store the event.
+ * @return return_t Returns return_success or return_busy.
+ */
+return_t ButtonEvent_Pop(ButtonEventQueue_t *queue, ButtonEvent_t *event) {
+	return (ButtonEvent_PopBatch(queue, event, 1U) == 1U) ?
+			return_success : return_busy;
+}
+
+/*!
+ * @fn     size_t ButtonEvent_PopBatch(ButtonEventQueue_t *queue, ButtonEvent_t *events, size_t maxEvents).
+ * @brief  Takes up to maxEvents of the oldest events at once, consumer side only.
+ * @param  queue Pointer to the ButtonEventQueue_t structure.
+ * @param  events Array to store the events.
+ * @param  maxEvents Capacity of the events array.
+ * @return size_t Number of events stored.
+ */
+size_t ButtonEvent_PopBatch(ButtonEventQueue_t *queue, ButtonEvent_t *events,
+		size_t maxEvents) {
+
+	/* Local variable & initial */
+	uint32_t tail = queue->tail;
+	uint32_t available = queue->head - tail;
+	size_t count = 0;
+
+	BUTTON_EVENT_BARRIER(); /* read events only after seeing head */
+	while (count < maxEvents && count < available) {
+		events[count] = queue->events[BUTTON_EVENT_SLOT(tail + count)];
+		count++;
+	}
+	BUTTON_EVENT_BARRIER(); /* events copied before their slots are released */
+	queue->tail = tail + (uint32_t) count;
+
+	return count;
+}
+
+/* 3. Local Function Declarations */
+
+/************************ (C) COPYRIGHT [KeyhanSalehi] *****END OF FILE****/
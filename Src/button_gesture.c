@@ -0,0 +1,99 @@
+/**
+ ******************************************************************************
+ * @file           : button_gesture.c
+ * @author         : KeyhanSalehi
+ * @brief          : Implementation of the Button Gesture matcher.
+ ******************************************************************************
+ * @attention
+ *
+ * A whole gesture is one integer, so matching is a binary search of
+ * integer compares over the const table, no parsing and no allocation.
+ *
+ ******************************************************************************
+ */
+
+/* Includes ------------------------------------------------------------------*/
+
+/* 1. System Header Files */
+
+/* 2. Project Header Files */
+
+/* 3. Module Header File */
+#include "button_gesture.h"
+
+/* Defines & Macros ----------------------------------------------------------*/
+/**
+ * @brief Constants and macros specific to this file.
+ */
+
+/* Typedefs ------------------------------------------------------------------*/
+/**
+ * @brief Typedefs for local use in this file.
+ */
+
+/* Variables -----------------------------------------------------------------*/
+
+/* 1. Global Variables */
+
+/* 2. Static Variables */
+
+/* Function Declarations -----------------------------------------------------*/
+
+/* 1. Local Prototype Functions */
+
+/* 2. Global Function Declarations */
+
+/*!
+ * @fn     return_t ButtonGesture_Match(const ButtonGesture_t *table, size_t count, uint32_t code, uint8_t *id).
+ * @brief  Looks a gesture code up in a table sorted by code.
+ * @param  table Gesture table, sorted by ascending code.
+ * @param  count Number of entries in the table.
+ * @param  code Gesture code.
+ * @param  id Pointer to store the id of the matching entry.
+ * @return return_t Returns return_success or return_failed.
+ */
+return_t ButtonGesture_Match(const ButtonGesture_t *table, size_t count,
+		uint32_t code, uint8_t *id) {
+
+	/* Local variable & initial */
+	size_t low = 0;
+	size_t high = count;
+
+	while (low < high) {
+		size_t middle = low + (high - low) / 2U;
+
+		if (table[middle].code == code) {
+			*id = table[middle].id;
+			return return_success;
+		}
+		if (table[middle].code < code) {
+			low = middle + 1U;
+		} else {
+			high = middle;
+		}
+	}
+
+	return return_failed;
+}
+
+/*!
+ * @fn     bool ButtonGesture_IsSorted(const ButtonGesture_t *table, size_t count).
+ * @brief  Checks that a table is sorted by strictly ascending code.
+ * @param  table Gesture table.
+ * @param  count Number of entries in the table.
+ * @return bool true if ButtonGesture_Match can search the table.
+ */
+bool ButtonGesture_IsSorted(const ButtonGesture_t *table, size_t count) {
+
+	for (size_t i = 1; i < count; i++) {
+		if (table[i - 1U].code >= table[i].code) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+/* 3. Local Function Declarations */
+
+/************************ (C) COPYRIGHT [KeyhanSalehi] *****END OF FILE****/
@@ -17,6 +17,8 @@
 /* 1. System Header Files */
 
 /* 2. Project Header Files */
+#include "button_trace.h"
+#include "button_gesture.h"
 
 /* 3. Module Header File */
 #include "button_handler.h"
@@ -26,11 +28,45 @@
  * @brief Constants and macros specific to this file.
  */
 
-/*! @def @brief Define for deBounce delay (50ms).*/
-#define DEBOUNCE_DELAY_MS 50
+/*! @def @brief button timers helpers matching the Button_t layout. */
+#if BUTTON_COMPACT_LAYOUT
+#define BUTTON_TIMER_RESET_AT(timer, tick) softTimer16_resetAt((timer), (tick))
+#define BUTTON_TIMER_ELAPSED_AT(timer, now, timeout) \
+		softTimer16_isElapsedAt((timer), (now), (timeout))
+#define BUTTON_TIMER_ELAPSED(timer, now) ((uint16_t) ((uint16_t) (now) - *(timer)))
+#define BUTTON_TIMER_REFRESH 0x8000U
+#else
+#define BUTTON_TIMER_RESET_AT(timer, tick) softTimer_resetAt((timer), (tick))
+#define BUTTON_TIMER_ELAPSED_AT(timer, now, timeout) \
+		softTimer_isElapsedAt((timer), (now), (timeout))
+#define BUTTON_TIMER_ELAPSED(timer, now) ((uint32_t) ((now) - *(timer)))
+#define BUTTON_TIMER_REFRESH 0x80000000UL
+#endif
 
-/*! @def @brief Define for timeout threshold (1 seconds).*/
-#define BUTTON_TIMEOUT_MS SEC_TO_MS(1)
+/*! @def @brief bumps an instrumentation counter, compiled out without stats. */
+#if BUTTON_STATS_ENABLE
+#define BUTTON_STATS_INC(button, counter) do { \
+		if ((button)->stats.counter != UINT16_MAX) { \
+			(button)->stats.counter++; \
+		} \
+	} while (0)
+#else
+#define BUTTON_STATS_INC(button, counter) ((void) 0)
+#endif
+
+/*! @def @brief true while an accepted press is held (keeps its sequence open). */
+#if BUTTON_HOLD_ENABLE
+#define BUTTON_IS_HELD(button) ((button)->isHeld)
+#else
+#define BUTTON_IS_HELD(button) (false)
+#endif
+
+#if BUTTON_ISR_SAFE
+/*! @def @brief fields of Button_t.published. */
+#define BUTTON_PUBLISHED_COUNT(word) ((uint8_t) (word))
+#define BUTTON_PUBLISHED_RESULT_SHIFT 8U
+#define BUTTON_PUBLISHED_PRESS_SHIFT 16U
+#endif
 
 /* Typedefs ------------------------------------------------------------------*/
 /**
@@ -43,15 +79,51 @@
 
 /* 2. Static Variables */
 
+/*! @brief queue Button_Process publishes events to. */
+static ButtonEventQueue_t *buttonQueue = NULL;
+
+#if BUTTON_TIMER_WHEEL_ENABLE
+/*! @brief wheel holding the sequence timeouts of all buttons. */
+static softTimerWheel_t *buttonWheel = NULL;
+#endif
+
 /* Function Declarations -----------------------------------------------------*/
 
 /* 1. Local Prototype Functions */
 
 /*! @fn @private */
-static return_t Button_CountPushes(Button_t *button);
+static return_t Button_CountPushes(Button_t *button, uint32_t now);
+/*! @fn @private */
+static void Button_ProcessState(Button_t *button, GPIO_PinState currentState,
+		uint32_t tick);
+/*! @fn @private */
+static void Button_PublishEvent(const Button_t *button, uint8_t type,
+		uint8_t count, uint16_t duration, uint32_t tick);
+#if BUTTON_HOLD_ENABLE
+/*! @fn @private */
+static void Button_ProcessHold(Button_t *button, uint32_t now);
+#endif
+#if BUTTON_ISR_SAFE
+/*! @fn @private */
+static void Button_PublishResult(Button_t *button, uint8_t count);
+#endif
+/*! @fn @private */
+static void Button_UpdateDeadline(uint32_t remaining, uint32_t now,
+		bool *isPending, uint32_t *deadline);
+#if BUTTON_TIMER_WHEEL_ENABLE
+/*! @fn @private */
+static void Button_TimeoutCallback(softTimerNode_t *node);
+#endif
+/*! @fn @private */
+static void Button_OpenHeld(Button_t *button, uint32_t now);
+#if BUTTON_EARLY_RESOLVE
+/*! @fn @private */
+static void Button_ResolveEarly(Button_t *button);
+#endif
 
 /* 2. Global Function Declarations */
 
+#if !BUTTON_CONFIG_IN_FLASH
 /*!
  * @fn     void Button_Init(Button_t *button, GPIO_TypeDef *port, uint16_t pin).
  * @brief  Initializes a button with specified port and pin.
@@ -62,18 +134,639 @@ static return_t Button_CountPushes(Button_t *button);
  */
 void Button_Init(Button_t *button, GPIO_TypeDef *port, uint16_t pin,
 		uint32_t pull) {
-	button->port = port;
-	button->pin = pin;
+	/* Local variable & initial */
+	const ButtonConfig_t config = BUTTON_CONFIG_INIT(port, pin, pull,
+			DEBOUNCE_DELAY_MS, BUTTON_TIMEOUT_MS, PUSH_COUNT_MAX);
+
+	Button_InitConfig(button, &config);
+
+	/*! @note massage for developer : Configure GPIO as input with pull-up in CubeMx */
+}
+#endif /* !BUTTON_CONFIG_IN_FLASH */
+
+/*!
+ * @fn     void Button_InitConfig(Button_t *button, const ButtonConfig_t *config).
+ * @brief  Initializes a button from a configuration.
+ * @param  button Pointer to the Button_t structure.
+ * @param  config Pointer to the configuration.
+ * @return void
+ */
+void Button_InitConfig(Button_t *button, const ButtonConfig_t *config) {
+	/* Local variable & initial */
+	uint32_t tick = SOFTTIMER_TICK();
+
+#if BUTTON_TIMER_WHEEL_ENABLE
+	/* the first press arms its timeout in the wheel */
+	assert(buttonWheel != NULL);
+#endif
+
+#if BUTTON_COMPACT_LAYOUT
+	uint8_t bit = 0;
+
+	while (bit < 15U && (config->pin >> bit) != 1U) {
+		bit++;
+	}
+	button->portIndex = (uint8_t) (((uintptr_t) config->port - BUTTON_GPIO_BASE)
+			/ BUTTON_GPIO_STRIDE);
+	button->pinBit = bit;
+	button->activeState = config->activeState & 1U;
+#elif BUTTON_CONFIG_IN_FLASH
+	button->config = config;
+#else
+	button->config = *config;
+#endif
 	button->pushCount = 0;
 	button->isReadFinish = false;
-	softTimer_reset(&button->debounceTimer); /* Initialize deBounce timer */
-	softTimer_reset(&button->timeoutTimer); /* Initialize timeout timer */
+	button->isPressPending = false;
+	button->isPressHeld = false;
+#if BUTTON_ISR_SAFE
+	button->published = 0;
+	button->resultTaken = 0;
+	button->pressTaken = 0;
+#if BUTTON_HOLD_ENABLE
+	button->holdPublished = 0;
+	button->holdTaken = 0;
+#endif
+#endif
+	BUTTON_TIMER_RESET_AT(&button->debounceTimer, tick); /* Initialize deBounce timer */
+#if BUTTON_TIMER_WHEEL_ENABLE
+	softTimerWheel_initNode(&button->timeoutNode, Button_TimeoutCallback, button);
+#else
+	BUTTON_TIMER_RESET_AT(&button->timeoutTimer, tick); /* Initialize timeout timer */
+#endif
 	button->lastState = GPIO_PIN_RESET;
-	button->pull = pull; /* Store the pull configuration */
+	button->source = BUTTON_SOURCE_POLL;
+	button->id = 0;
+#if !BUTTON_COMPACT_LAYOUT
+	button->pressDuration = 0;
+#endif
+#if BUTTON_TRACE_ENABLE
+	button->trace = NULL;
+#endif
+#if BUTTON_STATS_ENABLE
+	Button_ResetStats(button);
+#endif
+#if BUTTON_GESTURE_ENABLE
+	button->gesture = 0;
+#endif
+#if BUTTON_HOLD_ENABLE
+	button->isHeld = false;
+	button->isHoldPending = false;
+	button->holdCount = 0;
+	softTimer_resetAt(&button->holdTimer, tick);
+#endif
+#if BUTTON_EXTI_ENABLE
+	button->edgeHead = 0;
+	button->edgeTail = 0;
+#endif
+}
 
-	/*! @note massage for developer : Configure GPIO as input with pull-up in CubeMx */
+/*!
+ * @fn     void Button_InitTable(Button_t *buttons, const ButtonConfig_t *configs, size_t count).
+ * @brief  Initializes an array of buttons from an array of configurations.
+ * @param  buttons Array of buttons.
+ * @param  configs Array of configurations, one per button.
+ * @param  count Number of buttons.
+ * @return void
+ */
+void Button_InitTable(Button_t *buttons, const ButtonConfig_t *configs,
+		size_t count) {
+	for (size_t i = 0; i < count; i++) {
+		Button_InitConfig(&buttons[i], &configs[i]);
+		buttons[i].id = (uint8_t) i;
+	}
+}
+
+#if !BUTTON_CONFIG_IN_FLASH && !BUTTON_COMPACT_LAYOUT
+/*!
+ * @fn     void Button_SetTiming(Button_t *button, uint16_t debounceMs, uint16_t timeoutMs).
+ * @brief  Changes the debounce delay and sequence timeout of a button.
+ * @param  button Pointer to the Button_t structure.
+ * @param  debounceMs Minimum time between two presses in ms.
+ * @param  timeoutMs Idle time closing a sequence in ms.
+ * @return void
+ */
+void Button_SetTiming(Button_t *button, uint16_t debounceMs, uint16_t timeoutMs) {
+
+	/* Local variable & initial */
+	uint32_t debounceTicks = SOFTTIMER_MS_TO_TICKS(debounceMs);
+
+	button->config.debounceTime = (debounceTicks > UINT16_MAX) ?
+			UINT16_MAX : (uint16_t) debounceTicks;
+	button->config.timeoutTime = timeoutMs;
+}
+
+/*!
+ * @fn     void Button_SetDebounceTicks(Button_t *button, uint16_t debounceTicks).
+ * @brief  Changes the debounce delay of a button in ticks.
+ * @param  button Pointer to the Button_t structure.
+ * @param  debounceTicks Minimum time between two presses in ticks.
+ * @return void
+ */
+void Button_SetDebounceTicks(Button_t *button, uint16_t debounceTicks) {
+	button->config.debounceTime = debounceTicks;
+}
+
+/*!
+ * @fn     void Button_SetMaxCount(Button_t *button, uint8_t maxCount).
+ * @brief  Changes the highest valid push count of a button.
+ * @param  button Pointer to the Button_t structure.
+ * @param  maxCount Highest valid push count.
+ * @return void
+ */
+void Button_SetMaxCount(Button_t *button, uint8_t maxCount) {
+	button->config.maxCount = maxCount;
+}
+
+#if BUTTON_HOLD_ENABLE
+/*!
+ * @fn     void Button_SetHoldTiming(Button_t *button, uint16_t longPressMs, uint16_t repeatMs).
+ * @brief  Changes the long press time and auto-repeat period of a button.
+ * @param  button Pointer to the Button_t structure.
+ * @param  longPressMs Hold time reported as a long press in ms (0 disables).
+ * @param  repeatMs Auto-repeat period after the long press in ms (0 disables).
+ * @return void
+ */
+void Button_SetHoldTiming(Button_t *button, uint16_t longPressMs,
+		uint16_t repeatMs) {
+	button->config.longPressTime = longPressMs;
+	button->config.repeatTime = repeatMs;
+}
+#endif
+#endif /* !BUTTON_CONFIG_IN_FLASH && !BUTTON_COMPACT_LAYOUT */
+
+/*!
+ * @fn     void Button_RegisterPress(Button_t *button, uint32_t tick).
+ * @brief  Counts one already debounced press of the button.
+ * @param  button Pointer to the Button_t structure.
+ * @param  tick Tick at which the press was detected.
+ * @return void
+ */
+void Button_RegisterPress(Button_t *button, uint32_t tick) {
+
+	/* first press of a sequence is reported without waiting for it to close */
+	if (Button_CountPress(button, tick)) {
+		Button_ReportPress(button, tick);
+	}
+}
+
+/*!
+ * @fn     bool Button_CountPress(Button_t *button, uint32_t tick).
+ * @brief  Counts one already debounced press without reporting it.
+ * @param  button Pointer to the Button_t structure.
+ * @param  tick Tick at which the press was detected.
+ * @return bool true if the press started a sequence.
+ */
+bool Button_CountPress(Button_t *button, uint32_t tick) {
+
+	/* Local variable & initial */
+	bool isFirst = (button->pushCount == 0U) || button->isReadFinish;
+
+	/* banked buttons never sample their pin, keep their state here */
+	button->lastState = BUTTON_ACTIVE_STATE(button);
+	BUTTON_TIMER_RESET_AT(&button->debounceTimer, tick);
+	BUTTON_STATS_INC(button, accepted);
+#if BUTTON_HOLD_ENABLE
+	button->isHeld = true;
+	button->holdCount = 0;
+	softTimer_resetAt(&button->holdTimer, tick);
+#endif
+
+	/* the closed sequence waits for its read, this press opens the next one */
+	if (button->isReadFinish) {
+		button->isPressHeld = true;
+		return isFirst;
+	}
+
+#if BUTTON_TIMER_WHEEL_ENABLE
+	softTimerWheel_start(buttonWheel, &button->timeoutNode, tick,
+			BUTTON_TIMEOUT(button));
+#else
+	BUTTON_TIMER_RESET_AT(&button->timeoutTimer, tick);
+#endif
+#if BUTTON_OVERFLOW_POLICY == BUTTON_OVERFLOW_RESET
+	button->pushCount++;
+#else
+	if (button->pushCount < BUTTON_MAX_COUNT(button)) {
+		button->pushCount++;
+	} else {
+		BUTTON_STATS_INC(button, overflows);
+#if BUTTON_OVERFLOW_POLICY == BUTTON_OVERFLOW_WRAP
+		button->pushCount = 1;
+#endif
+	}
+#endif
+#if BUTTON_GESTURE_ENABLE
+	if (isFirst) {
+		button->gesture = BUTTON_GESTURE_EMPTY;
+	} else if (tick - button->releaseTick
+			>= SOFTTIMER_MS_TO_TICKS(BUTTON_GESTURE_PAUSE_MS)) {
+		button->gesture = ButtonGesture_Append(button->gesture,
+				BUTTON_GESTURE_PAUSE);
+	}
+#endif
+
+#if BUTTON_EARLY_RESOLVE && !BUTTON_GESTURE_ENABLE
+	/* no further press can make this sequence valid, close it now */
+	if (button->pushCount >= BUTTON_MAX_COUNT(button)) {
+		Button_ResolveEarly(button);
+	}
+#endif
+
+	return isFirst;
+}
+
+/*!
+ * @fn     void Button_ReportPress(Button_t *button, uint32_t tick).
+ * @brief  Reports the first press of a sequence.
+ * @param  button Pointer to the Button_t structure.
+ * @param  tick Tick of the event.
+ * @return void
+ */
+void Button_ReportPress(Button_t *button, uint32_t tick) {
+	button->isPressPending = true;
+#if BUTTON_ISR_SAFE
+	button->published += 1UL << BUTTON_PUBLISHED_PRESS_SHIFT;
+#endif
+	Button_PublishEvent(button, BUTTON_EVENT_PRESS, 1U, 0U, tick);
+}
+
+/*!
+ * @fn     void Button_RegisterRelease(Button_t *button, uint32_t tick).
+ * @brief  Records the release of a press fed by Button_RegisterPress.
+ * @param  button Pointer to the Button_t structure.
+ * @param  tick Tick at which the release was detected.
+ * @return void
+ */
+void Button_RegisterRelease(Button_t *button, uint32_t tick) {
+	button->lastState = (GPIO_PinState) (BUTTON_ACTIVE_STATE(button) ^ GPIO_PIN_SET);
+#if BUTTON_COMPACT_LAYOUT
+	(void) tick;
+#else
+	/* the debounce timer starts at the accepted press */
+	uint32_t duration = SOFTTIMER_TICKS_TO_MS(tick - button->debounceTimer);
+
+	button->pressDuration = (duration > UINT16_MAX) ?
+			UINT16_MAX : (uint16_t) duration;
+#if BUTTON_GESTURE_ENABLE
+	/* a release after its sequence closed belongs to no gesture, but a held
+	 * press still starts the pause before the next one */
+	button->releaseTick = tick;
+	if (button->pushCount > 0U && !button->isReadFinish) {
+		button->gesture = ButtonGesture_Append(button->gesture,
+				(duration >= BUTTON_GESTURE_LONG_MS) ?
+						BUTTON_GESTURE_LONG : BUTTON_GESTURE_SHORT);
+#if BUTTON_EARLY_RESOLVE
+		/* the last symbol is only known now, close the sequence after it */
+		if (button->pushCount >= BUTTON_MAX_COUNT(button)) {
+			Button_ResolveEarly(button);
+		}
+#endif
+	}
+#endif
+#if BUTTON_HOLD_ENABLE
+	/* the sequence closes the timeout after the last release */
+	if (button->isHeld) {
+		button->isHeld = false;
+		if (button->holdCount == 0U) {
+#if BUTTON_TIMER_WHEEL_ENABLE
+			softTimerWheel_start(buttonWheel, &button->timeoutNode, tick,
+					BUTTON_TIMEOUT(button));
+#else
+			softTimer_resetAt(&button->timeoutTimer, tick);
+#endif
+		}
+	}
+#endif
+#endif
+}
+
+/*!
+ * @fn     void Button_Cancel(Button_t *button).
+ * @brief  Drops the sequence in progress without reporting it.
+ * @param  button Pointer to the Button_t structure.
+ * @return void
+ */
+void Button_Cancel(Button_t *button) {
+	button->pushCount = 0;
+	button->isReadFinish = false;
+	button->isPressPending = false;
+	button->isPressHeld = false;
+#if BUTTON_HOLD_ENABLE
+	button->isHeld = false;
+	button->isHoldPending = false;
+#endif
+#if BUTTON_TIMER_WHEEL_ENABLE
+	softTimerWheel_stop(&button->timeoutNode);
+#endif
+}
+
+/*!
+ * @fn     void Button_SetId(Button_t *button, uint8_t id).
+ * @brief  Sets the id the button reports in its events.
+ * @param  button Pointer to the Button_t structure.
+ * @param  id Button id.
+ * @return void
+ */
+void Button_SetId(Button_t *button, uint8_t id) {
+	button->id = id;
+}
+
+/*!
+ * @fn     void Button_SetEventQueue(ButtonEventQueue_t *queue).
+ * @brief  Sets the queue Button_Process publishes events to.
+ * @param  queue Pointer to an initialized ButtonEventQueue_t, or NULL.
+ * @return void
+ */
+void Button_SetEventQueue(ButtonEventQueue_t *queue) {
+	buttonQueue = queue;
+}
+
+/*!
+ * @fn     ButtonEventQueue_t* Button_GetEventQueue(void).
+ * @brief  Gets the queue set by Button_SetEventQueue.
+ * @return ButtonEventQueue_t* Event queue, or NULL when none is set.
+ */
+ButtonEventQueue_t* Button_GetEventQueue(void) {
+	return buttonQueue;
+}
+
+/*!
+ * @fn     void Button_Process(Button_t *button).
+ * @brief  Runs the button engine and publishes closed sequences as events.
+ * @param  button Pointer to the Button_t structure.
+ * @return void
+ */
+void Button_Process(Button_t *button) {
+	Button_ProcessAt(button, SOFTTIMER_TICK());
+}
+
+/*!
+ * @fn     void Button_ProcessAt(Button_t *button, uint32_t now).
+ * @brief  Same as Button_Process, with the tick snapshot of the pass.
+ * @param  button Pointer to the Button_t structure.
+ * @param  now Tick read once for the whole pass.
+ * @return void
+ */
+void Button_ProcessAt(Button_t *button, uint32_t now) {
+
+	/* Local variable & initial */
+	uint8_t count = 0;
+
+	if (Button_GetFinalCountAt(button, &count, now) == return_success) {
+#if BUTTON_COMPACT_LAYOUT
+		Button_PublishEvent(button, BUTTON_EVENT_CLICKS, count, 0U, now);
+#else
+		Button_PublishEvent(button, BUTTON_EVENT_CLICKS, count,
+				button->pressDuration, now);
+#endif
+	}
+}
+
+/*!
+ * @fn     size_t Button_ProcessAll(Button_t *buttons, size_t count, ButtonResult_t *results).
+ * @brief  Runs Button_Process over an array with one tick snapshot.
+ * @param  buttons Array of buttons.
+ * @param  count Number of buttons in the array.
+ * @param  results Array of count entries to store the closed sequences.
+ * @return size_t Number of results stored.
+ */
+size_t Button_ProcessAll(Button_t *buttons, size_t count,
+		ButtonResult_t *results) {
+
+	/* Local variable & initial */
+	uint32_t now = SOFTTIMER_TICK();
+	size_t resultCount = 0;
+
+	for (size_t i = 0; i < count; i++) {
+		Button_t *button = &buttons[i];
+		uint8_t pushes;
+
+		if (Button_GetFinalCountAt(button, &pushes, now) != return_success) {
+			continue;
+		}
+
+		results[resultCount].index = (uint16_t) i;
+		results[resultCount].id = button->id;
+		results[resultCount].count = pushes;
+		resultCount++;
+#if BUTTON_COMPACT_LAYOUT
+		Button_PublishEvent(button, BUTTON_EVENT_CLICKS, pushes, 0U, now);
+#else
+		Button_PublishEvent(button, BUTTON_EVENT_CLICKS, pushes,
+				button->pressDuration, now);
+#endif
+	}
+
+	return resultCount;
+}
+
+#if BUTTON_GESTURE_ENABLE
+/*!
+ * @fn     uint32_t Button_GetGesture(const Button_t *button).
+ * @brief  Gets the gesture code of the last closed sequence.
+ * @param  button Pointer to the Button_t structure.
+ * @return uint32_t Gesture code, 0 when it overflowed.
+ */
+uint32_t Button_GetGesture(const Button_t *button) {
+	return button->gesture;
+}
+#endif
+
+#if BUTTON_STATS_ENABLE
+/*!
+ * @fn     void Button_GetStats(const Button_t *button, ButtonStats_t *stats).
+ * @brief  Copies the instrumentation counters of a button.
+ * @param  button Pointer to the Button_t structure.
+ * @param  stats Pointer to store the counters.
+ * @return void
+ */
+void Button_GetStats(const Button_t *button, ButtonStats_t *stats) {
+	*stats = button->stats;
+}
+
+/*!
+ * @fn     void Button_ResetStats(Button_t *button).
+ * @brief  Clears the instrumentation counters of a button.
+ * @param  button Pointer to the Button_t structure.
+ * @return void
+ */
+void Button_ResetStats(Button_t *button) {
+	memset(&button->stats, 0, sizeof(button->stats));
+	button->stats.lastPoll = SOFTTIMER_TICK();
+}
+#endif /* BUTTON_STATS_ENABLE */
+
+/*!
+ * @fn     bool Button_NextDeadline(const Button_t *buttons, size_t count, uint32_t now, uint32_t *deadline).
+ * @brief  Finds the earliest tick at which any of the buttons needs a poll.
+ * @param  buttons Array of buttons.
+ * @param  count Number of buttons in the array.
+ * @param  now Current tick (SOFTTIMER_TICK()).
+ * @param  deadline Pointer to store the earliest deadline tick.
+ * @return bool true if a deadline is pending, false otherwise.
+ */
+bool Button_NextDeadline(const Button_t *buttons, size_t count, uint32_t now,
+		uint32_t *deadline) {
+
+	/* Local variable & initial */
+	bool isPending = false;
+
+	for (size_t i = 0; i < count; i++) {
+		const Button_t *button = &buttons[i];
+
+		/* a result, a held press or queued edges are waiting right now */
+		if (button->isReadFinish || button->isPressHeld
+#if BUTTON_EXTI_ENABLE
+				|| button->edgeTail != button->edgeHead
+#endif
+				) {
+			Button_UpdateDeadline(0U, now, &isPending, deadline);
+			continue;
+		}
+
+#if BUTTON_HOLD_ENABLE
+		/* next hold event, the sequence stays open while held */
+		if (button->isHeld) {
+			uint32_t interval = (button->holdCount == 0U) ?
+					BUTTON_LONG_PRESS(button) : BUTTON_REPEAT(button);
+			uint32_t elapsed = now - button->holdTimer;
+
+			if (interval != 0U && button->holdCount != UINT8_MAX) {
+				Button_UpdateDeadline((elapsed < interval) ? interval - elapsed : 0U,
+						now, &isPending, deadline);
+			}
+			continue;
+		}
+#endif
+
+		/* next press accepted by the debounce of a polled pin */
+		if (button->source == BUTTON_SOURCE_POLL) {
+			uint32_t elapsed = BUTTON_TIMER_ELAPSED(&button->debounceTimer, now);
+
+			if (elapsed < BUTTON_DEBOUNCE(button)) {
+				Button_UpdateDeadline(BUTTON_DEBOUNCE(button) - elapsed, now,
+						&isPending, deadline);
+			}
+		}
+
+		/* close of a sequence in progress */
+		if (button->pushCount > 0U) {
+#if BUTTON_TIMER_WHEEL_ENABLE
+			int32_t remaining = (int32_t) (button->timeoutNode.deadline - now);
+
+			if (softTimerWheel_isRunning(&button->timeoutNode)) {
+				Button_UpdateDeadline((remaining > 0) ? (uint32_t) remaining : 0U,
+						now, &isPending, deadline);
+			}
+#else
+			uint32_t elapsed = BUTTON_TIMER_ELAPSED(&button->timeoutTimer, now);
+
+			Button_UpdateDeadline(
+					(elapsed < BUTTON_TIMEOUT(button)) ?
+							BUTTON_TIMEOUT(button) - elapsed : 0U,
+					now, &isPending, deadline);
+#endif
+		}
+	}
+
+	return isPending;
+}
+
+#if BUTTON_TIMER_WHEEL_ENABLE
+/*!
+ * @fn     void Button_SetTimerWheel(softTimerWheel_t *wheel).
+ * @brief  Sets the wheel all buttons register their timeouts with.
+ * @param  wheel Pointer to an initialized softTimerWheel_t.
+ * @return void
+ */
+void Button_SetTimerWheel(softTimerWheel_t *wheel) {
+	buttonWheel = wheel;
 }
 
+/*!
+ * @fn     softTimerWheel_t* Button_GetTimerWheel(void).
+ * @brief  Gets the wheel the buttons register their timeouts with.
+ * @return softTimerWheel_t* Wheel set by Button_SetTimerWheel, or NULL.
+ */
+softTimerWheel_t* Button_GetTimerWheel(void) {
+	return buttonWheel;
+}
+#endif /* BUTTON_TIMER_WHEEL_ENABLE */
+
+#if BUTTON_EXTI_ENABLE
+#if !BUTTON_CONFIG_IN_FLASH
+/*!
+ * @fn     void Button_InitEXTI(Button_t *button, GPIO_TypeDef *port, uint16_t pin, uint32_t pull).
+ * @brief  Initializes a button whose edges are captured by the EXTI interrupt.
+ * @param  button Pointer to the Button_t structure.
+ * @param  port GPIO port.
+ * @param  pin GPIO pin.
+ * @param  pull Pull configuration (GPIO_PULLUP, GPIO_PULLDOWN, or GPIO_NOPULL).
+ * @return void
+ */
+void Button_InitEXTI(Button_t *button, GPIO_TypeDef *port, uint16_t pin,
+		uint32_t pull) {
+	Button_Init(button, port, pin, pull);
+	Button_EnableEXTI(button);
+}
+#endif /* !BUTTON_CONFIG_IN_FLASH */
+
+/*!
+ * @fn     void Button_EnableEXTI(Button_t *button).
+ * @brief  Switches an initialized button to EXTI edge capture.
+ * @param  button Pointer to the Button_t structure.
+ * @return void
+ */
+void Button_EnableEXTI(Button_t *button) {
+	/* No further reads happen, so start from the real pin level */
+	button->lastState = Button_ReadRaw(button);
+	button->source = BUTTON_SOURCE_EXTI;
+
+	/*! @note massage for developer : Configure GPIO as EXTI on both edges in CubeMx */
+}
+
+/*!
+ * @fn     void Button_EXTI_Callback(Button_t *button).
+ * @brief  Timestamps a pin transition of the button, call from the EXTI ISR.
+ * @param  button Pointer to the Button_t structure.
+ * @return void
+ */
+void Button_EXTI_Callback(Button_t *button) {
+	Button_QueueEdge(button, SOFTTIMER_TICK(), Button_ReadRaw(button));
+}
+
+/*!
+ * @fn     void Button_QueueEdge(Button_t *button, uint32_t tick, GPIO_PinState state).
+ * @brief  Queues a pin transition timestamped by the caller.
+ * @param  button Pointer to the Button_t structure.
+ * @param  tick Tick of the transition.
+ * @param  state Pin state after the transition.
+ * @return void
+ */
+void Button_QueueEdge(Button_t *button, uint32_t tick, GPIO_PinState state) {
+
+	/* Local variable & initial */
+	uint8_t head = button->edgeHead;
+	uint8_t next = (uint8_t) ((head + 1U) & (BUTTON_EXTI_QUEUE_SIZE - 1U));
+
+	/* queue full, fold this edge into the newest one so the final level is
+	 * kept; the replay only loses the bounce in between */
+	if (next == button->edgeTail) {
+		uint8_t last = (uint8_t) ((head - 1U) & (BUTTON_EXTI_QUEUE_SIZE - 1U));
+
+		button->edgeTick[last] = tick;
+		button->edgeState[last] = (uint8_t) state;
+		BUTTON_STATS_INC(button, droppedEdges);
+		return;
+	}
+
+	button->edgeTick[head] = tick;
+	button->edgeState[head] = (uint8_t) state;
+	button->edgeHead = next; /* publish the edge after its data is written */
+}
+#endif /* BUTTON_EXTI_ENABLE */
+
 /*!
  * @fn     return_t Button_GetFinalCount(Button_t *button, uint8_t *finalCount).
  * @brief  Gets the final button push count after validation.
@@ -82,14 +775,33 @@ void Button_Init(Button_t *button, GPIO_TypeDef *port, uint16_t pin,
  * @return return_t Returns return_success, return_failed, or return_busy.
  */
 return_t Button_GetFinalCount(Button_t *button, uint8_t *finalCount) {
+	return Button_GetFinalCountAt(button, finalCount, SOFTTIMER_TICK());
+}
+
+/*!
+ * @fn     return_t Button_GetFinalCountAt(Button_t *button, uint8_t *finalCount, uint32_t now).
+ * @brief  Same as Button_GetFinalCount, with the tick snapshot of the pass.
+ * @param  button Pointer to the Button_t structure.
+ * @param  finalCount Pointer to store the final push count.
+ * @param  now Tick read once for the whole pass.
+ * @return return_t Returns return_success, return_failed, or return_busy.
+ */
+return_t Button_GetFinalCountAt(Button_t *button, uint8_t *finalCount,
+		uint32_t now) {
 
 	/* local variable */
 	return_t finalResult = return_busy;
-	return_t countResult = Button_CountPushes(button); /* save result */
+	return_t countResult;
+
+	/* the last result was read (its gesture too), open the held press */
+	if (button->isPressHeld && !button->isReadFinish) {
+		Button_OpenHeld(button, now);
+	}
+	countResult = Button_CountPushes(button, now); /* save result */
 
 	/* check result */
 	if (countResult == return_success) {
-		if (button->pushCount > 0 && button->pushCount <= PUSH_COUNT_MAX) {
+		if (button->pushCount > 0 && button->pushCount <= BUTTON_MAX_COUNT(button)) {
 			*finalCount = button->pushCount;
 			finalResult = return_success;
 		} else {
@@ -102,47 +814,236 @@ return_t Button_GetFinalCount(Button_t *button, uint8_t *finalCount) {
 		finalResult = countResult;
 	}
 
+#if BUTTON_ISR_SAFE
+	if (finalResult != return_busy) {
+		Button_PublishResult(button,
+				(finalResult == return_success) ? *finalCount : 0U);
+	}
+#endif
+
 	/* return final result */
 	return finalResult;
 }
 
+#if BUTTON_ISR_SAFE
+/*!
+ * @fn     return_t Button_ReadResult(Button_t *button, uint8_t *finalCount).
+ * @brief  Takes the latest result published by the engine, from any context.
+ * @param  button Pointer to the Button_t structure.
+ * @param  finalCount Pointer to store the final push count.
+ * @return return_t Returns return_success, return_failed, or return_busy.
+ */
+return_t Button_ReadResult(Button_t *button, uint8_t *finalCount) {
+
+	/* Local variable & initial */
+	uint32_t word = button->published; /* one load, a consistent snapshot */
+	uint8_t sequence = (uint8_t) (word >> BUTTON_PUBLISHED_RESULT_SHIFT);
+
+	if (sequence == button->resultTaken) {
+		return return_busy;
+	}
+	button->resultTaken = sequence;
+
+	if (BUTTON_PUBLISHED_COUNT(word) == 0U) {
+		return return_failed;
+	}
+
+	*finalCount = BUTTON_PUBLISHED_COUNT(word);
+	return return_success;
+}
+#endif /* BUTTON_ISR_SAFE */
+
+/*!
+ * @fn     return_t Button_GetPress(Button_t *button).
+ * @brief  Reports the first debounced press of a sequence right away.
+ * @param  button Pointer to the Button_t structure.
+ * @return return_t Returns return_success or return_busy.
+ */
+return_t Button_GetPress(Button_t *button) {
+#if BUTTON_ISR_SAFE
+	/* Local variable & initial */
+	uint8_t sequence = (uint8_t) (button->published
+			>> BUTTON_PUBLISHED_PRESS_SHIFT);
+
+	if (sequence != button->pressTaken) {
+		button->pressTaken = sequence;
+		return return_success;
+	}
+#else
+	if (button->isPressPending) {
+		button->isPressPending = false;
+		return return_success;
+	}
+#endif
+
+	return return_busy;
+}
+
+#if BUTTON_HOLD_ENABLE
+/*!
+ * @fn     return_t Button_GetLongPress(Button_t *button, uint8_t *repeatCount).
+ * @brief  Reports long-press and auto-repeat events of a held button.
+ * @param  button Pointer to the Button_t structure.
+ * @param  repeatCount Pointer to store 0 for the long press, then the repeat number.
+ * @return return_t Returns return_success or return_busy.
+ */
+return_t Button_GetLongPress(Button_t *button, uint8_t *repeatCount) {
+#if BUTTON_ISR_SAFE
+	/* Local variable & initial */
+	uint16_t word = button->holdPublished; /* one load, a consistent snapshot */
+	uint8_t sequence = (uint8_t) (word >> 8);
+
+	if (sequence != button->holdTaken) {
+		button->holdTaken = sequence;
+		*repeatCount = (uint8_t) word;
+		return return_success;
+	}
+#else
+	if (button->isHoldPending) {
+		button->isHoldPending = false;
+		*repeatCount = (uint8_t) (button->holdCount - 1U);
+		return return_success;
+	}
+#endif
+
+	return return_busy;
+}
+
+/*!
+ * @fn     uint32_t Button_GetPressDuration(const Button_t *button, uint32_t now).
+ * @brief  Gets how long the button is held, or how long its last press lasted.
+ * @param  button Pointer to the Button_t structure.
+ * @param  now Current tick (SOFTTIMER_TICK()).
+ * @return uint32_t Duration in ms.
+ */
+uint32_t Button_GetPressDuration(const Button_t *button, uint32_t now) {
+	/* the debounce timer starts at the accepted press */
+	if (button->isHeld) {
+		return SOFTTIMER_TICKS_TO_MS(now - button->debounceTimer);
+	}
+
+	return button->pressDuration;
+}
+#endif /* BUTTON_HOLD_ENABLE */
+
 /* 3. Local Function Declarations */
 
 /*!
- * @fn     static return_t Button_CountPushes(Button_t *button).
+ * @fn     static return_t Button_CountPushes(Button_t *button, uint32_t now).
  * @brief  Counts the number of button pushes.
  * @param  button Pointer to the Button_t structure.
+ * @param  now Tick of this poll.
  * @return return_t Returns return_success, return_failed, or return_busy.
  */
-static return_t Button_CountPushes(Button_t *button) {
+static return_t Button_CountPushes(Button_t *button, uint32_t now) {
+
+#if BUTTON_STATS_ENABLE
+	/* a long gap here means the main loop samples too slowly */
+	uint32_t interval = now - button->stats.lastPoll;
+
+	button->stats.lastPoll = now;
+	if (interval > button->stats.maxPollInterval) {
+		button->stats.maxPollInterval = (interval > UINT16_MAX) ?
+				UINT16_MAX : (uint16_t) interval;
+	}
+#endif
 
 	/* Local variable & initial */
-	GPIO_PinState currentState = HAL_GPIO_ReadPin(button->port, button->pin);
-	/* Determine the active and inactive states based on pull configuration */
-	GPIO_PinState activeState =
-			(button->pull == GPIO_PULLUP) ? GPIO_PIN_RESET : GPIO_PIN_SET;
-	GPIO_PinState inactiveState =
-			(button->pull == GPIO_PULLUP) ? GPIO_PIN_SET : GPIO_PIN_RESET;
+	GPIO_PinState state = (GPIO_PinState) button->lastState;
 
-	/* Check for state transition with debounCing */
-	if (currentState == activeState && button->lastState == inactiveState) {
-		if (softTimer_isElapsed(&button->debounceTimer, DEBOUNCE_DELAY_MS)) {
-			softTimer_reset(&button->debounceTimer); /* Reset deBounce timer on valid press */
-			softTimer_reset(&button->timeoutTimer);
-			button->pushCount++;
+	if (button->source == BUTTON_SOURCE_POLL) {
+		state = Button_ReadRaw(button);
+	}
+
+	/* idle fast path: no sequence (so no timeout), pin unchanged */
+	if (Button_GetState(button) == BUTTON_STATE_IDLE
+			&& state == (GPIO_PinState) button->lastState
+			&& !BUTTON_IS_HELD(button)
+#if BUTTON_EXTI_ENABLE
+			&& button->edgeTail == button->edgeHead
+#endif
+			&& BUTTON_TIMER_ELAPSED(&button->debounceTimer, now)
+					< BUTTON_TIMER_REFRESH) {
+		return return_busy;
+	}
+
+#if BUTTON_EXTI_ENABLE
+	if (button->source == BUTTON_SOURCE_EXTI) {
+		/* Replay the queued edges with the tick they happened at */
+		while (button->edgeTail != button->edgeHead && !button->isReadFinish) {
+			uint8_t tail = button->edgeTail;
+			uint32_t edgeTick = button->edgeTick[tail];
+
+			/* sequence closed before this edge, leave it for the next one */
+#if BUTTON_TIMER_WHEEL_ENABLE
+			/* the deadline still holds when the wheel fired it before this poll */
+			if (button->pushCount > 0U && !BUTTON_IS_HELD(button)
+					&& (int32_t) (edgeTick - button->timeoutNode.deadline) >= 0) {
+				button->isReadFinish = true;
+				BUTTON_STATS_INC(button, timeouts);
+				softTimerWheel_stop(&button->timeoutNode);
+				break;
+			}
+#else
+			if (button->pushCount > 0U && !BUTTON_IS_HELD(button)
+					&& BUTTON_TIMER_ELAPSED_AT(&button->timeoutTimer, edgeTick,
+							BUTTON_TIMEOUT(button))) {
+				button->isReadFinish = true;
+				BUTTON_STATS_INC(button, timeouts);
+				break;
+			}
+#endif
+
+			Button_ProcessState(button, (GPIO_PinState) button->edgeState[tail],
+					edgeTick);
+			button->edgeTail = (uint8_t) ((tail + 1U)
+					& (BUTTON_EXTI_QUEUE_SIZE - 1U));
 		}
+#if BUTTON_TIMER_WHEEL_ENABLE
+		/* the wheel left this timeout to the poll, its edges are replayed now */
+		if (button->pushCount > 0U && !button->isReadFinish
+				&& !BUTTON_IS_HELD(button)
+				&& !softTimerWheel_isRunning(&button->timeoutNode)
+				&& (int32_t) (now - button->timeoutNode.deadline) >= 0) {
+			button->isReadFinish = true;
+			BUTTON_STATS_INC(button, timeouts);
+		}
+#endif
+	} else
+#endif /* BUTTON_EXTI_ENABLE */
+	if (button->source == BUTTON_SOURCE_POLL) {
+		Button_ProcessState(button, state, now);
 	}
-	button->lastState = currentState;
 
-	/* Check timeout (runs independently) */
-	if (softTimer_isElapsed(&button->timeoutTimer, BUTTON_TIMEOUT_MS)) {
+	/* pull the stamp of a long released button back to one debounce delay
+	 * before half its range, so the elapsed time never wraps (65 s with the
+	 * compact 16-bit stamps) */
+	if (button->lastState != BUTTON_ACTIVE_STATE(button)
+			&& BUTTON_TIMER_ELAPSED(&button->debounceTimer, now)
+					>= BUTTON_TIMER_REFRESH) {
+		BUTTON_TIMER_RESET_AT(&button->debounceTimer,
+				now - BUTTON_DEBOUNCE(button));
+	}
+
+#if BUTTON_HOLD_ENABLE
+	Button_ProcessHold(button, now);
+#endif
+
+#if !BUTTON_TIMER_WHEEL_ENABLE
+	/* the timeout is armed by the first press, only a counting sequence has one */
+	if (button->pushCount > 0U && !button->isReadFinish
+			&& !BUTTON_IS_HELD(button)
+			&& BUTTON_TIMER_ELAPSED_AT(&button->timeoutTimer, now,
+					BUTTON_TIMEOUT(button))) {
 		button->isReadFinish = true;
-		softTimer_reset(&button->timeoutTimer); /* Reset timeout timer */
+		BUTTON_STATS_INC(button, timeouts);
 	}
+#endif
 
 	/* check pushCount not overflow before send result */
-	if (button->pushCount > PUSH_COUNT_MAX) {
+	if (button->pushCount > BUTTON_MAX_COUNT(button)) {
 		button->pushCount = 0;
+		BUTTON_STATS_INC(button, overflows);
 		return return_failed;
 	}
 
@@ -153,4 +1054,223 @@ static return_t Button_CountPushes(Button_t *button) {
 	return return_busy;
 }
 
+/*!
+ * @fn     static void Button_ProcessState(Button_t *button, GPIO_PinState currentState, uint32_t tick).
+ * @brief  Applies one sampled pin state to the push counter.
+ * @param  button Pointer to the Button_t structure.
+ * @param  currentState Pin state that was sampled.
+ * @param  tick Tick at which the state was sampled.
+ * @return void
+ */
+static void Button_ProcessState(Button_t *button, GPIO_PinState currentState,
+		uint32_t tick) {
+
+	/* Active state is resolved once from the pull configuration */
+	GPIO_PinState activeState = BUTTON_ACTIVE_STATE(button);
+	GPIO_PinState inactiveState = (GPIO_PinState) (activeState ^ GPIO_PIN_SET);
+
+#if BUTTON_TRACE_ENABLE
+	/* every raw edge, bounces included */
+	if (button->trace != NULL && currentState != button->lastState) {
+		ButtonTrace_Record(button->trace, tick, (uint8_t) currentState);
+	}
+#endif
+
+	/* Check for state transition with debounCing */
+	if (currentState == activeState && button->lastState == inactiveState) {
+		if (BUTTON_TIMER_ELAPSED_AT(&button->debounceTimer, tick,
+				BUTTON_DEBOUNCE(button))) {
+			Button_RegisterPress(button, tick); /* Reset timers on valid press */
+		} else {
+			BUTTON_STATS_INC(button, bounceRejected);
+		}
+	} else if (currentState == inactiveState
+			&& button->lastState == activeState) {
+		Button_RegisterRelease(button, tick);
+	}
+	button->lastState = currentState;
+}
+
+#if BUTTON_HOLD_ENABLE
+/*!
+ * @fn     static void Button_ProcessHold(Button_t *button, uint32_t now).
+ * @brief  Raises the long press, then the auto-repeats, of a held button.
+ * @param  button Pointer to the Button_t structure.
+ * @param  now Current tick.
+ * @return void
+ */
+static void Button_ProcessHold(Button_t *button, uint32_t now) {
+
+	/* Local variable & initial */
+	uint32_t interval = (button->holdCount == 0U) ?
+			BUTTON_LONG_PRESS(button) : BUTTON_REPEAT(button);
+	uint32_t held = SOFTTIMER_TICKS_TO_MS(now - button->debounceTimer);
+	uint16_t duration = (held > UINT16_MAX) ? UINT16_MAX : (uint16_t) held;
+
+	/* a held press waits for its sequence to open */
+	if (!button->isHeld || button->isPressHeld || interval == 0U
+			|| button->holdCount == UINT8_MAX
+			|| !softTimer_isElapsedAt(&button->holdTimer, now, interval)) {
+		return;
+	}
+
+	softTimer_resetAt(&button->holdTimer, now);
+	button->holdCount++;
+	button->isHoldPending = true;
+#if BUTTON_ISR_SAFE
+	button->holdPublished = (uint16_t) ((((button->holdPublished >> 8) + 1U)
+			<< 8) | (uint8_t) (button->holdCount - 1U));
+#endif
+
+	if (button->holdCount == 1U) {
+		/* the long press ends the sequence, its clicks go with the event */
+		Button_PublishEvent(button, BUTTON_EVENT_LONG_PRESS, button->pushCount,
+				duration, now);
+		button->pushCount = 0;
+#if BUTTON_TIMER_WHEEL_ENABLE
+		softTimerWheel_stop(&button->timeoutNode);
+#endif
+	} else {
+		Button_PublishEvent(button, BUTTON_EVENT_REPEAT,
+				(uint8_t) (button->holdCount - 1U), duration, now);
+	}
+}
+#endif /* BUTTON_HOLD_ENABLE */
+
+#if BUTTON_ISR_SAFE
+/*!
+ * @fn     static void Button_PublishResult(Button_t *button, uint8_t count).
+ * @brief  Publishes a closed sequence to Button_ReadResult, engine side only.
+ * @param  button Pointer to the Button_t structure.
+ * @param  count Push count, 0 for an overflow.
+ * @return void
+ */
+static void Button_PublishResult(Button_t *button, uint8_t count) {
+
+	/* Local variable & initial */
+	uint32_t word = button->published;
+	uint32_t sequence = ((word >> BUTTON_PUBLISHED_RESULT_SHIFT) + 1U) & 0xFFU;
+
+	/* a single store, readers see the old or the new result, never a mix */
+	button->published = (word & ~0xFFFFUL)
+			| (sequence << BUTTON_PUBLISHED_RESULT_SHIFT) | count;
+}
+#endif /* BUTTON_ISR_SAFE */
+
+/*!
+ * @fn     static void Button_PublishEvent(const Button_t *button, uint8_t type, uint8_t count, uint16_t duration, uint32_t tick).
+ * @brief  Pushes an event of the button to the event queue, if one is set.
+ * @param  button Pointer to the Button_t structure.
+ * @param  type Event kind (ButtonEventType_t).
+ * @param  count Push count carried by the event.
+ * @param  duration Press duration carried by the event in ms.
+ * @param  tick Tick of the event.
+ * @return void
+ */
+static void Button_PublishEvent(const Button_t *button, uint8_t type,
+		uint8_t count, uint16_t duration, uint32_t tick) {
+
+	/* Local variable & initial */
+	ButtonEvent_t event = { 0 };
+
+	if (buttonQueue == NULL) {
+		return;
+	}
+
+	event.timestamp = tick;
+	event.duration = duration;
+	event.id = button->id;
+	event.type = type;
+	event.count = count;
+	(void) ButtonEvent_Push(buttonQueue, &event);
+}
+
+/*!
+ * @fn     static void Button_UpdateDeadline(uint32_t remaining, uint32_t now, bool *isPending, uint32_t *deadline).
+ * @brief  Keeps the earliest of the pending deadlines.
+ * @param  remaining Ticks left until this deadline.
+ * @param  now Current tick.
+ * @param  isPending Set once a first deadline is stored.
+ * @param  deadline Earliest deadline tick so far.
+ * @return void
+ */
+static void Button_UpdateDeadline(uint32_t remaining, uint32_t now,
+		bool *isPending, uint32_t *deadline) {
+	if (!*isPending || remaining < (uint32_t) (*deadline - now)) {
+		*deadline = now + remaining;
+		*isPending = true;
+	}
+}
+
+#if BUTTON_TIMER_WHEEL_ENABLE
+/*!
+ * @fn     static void Button_TimeoutCallback(softTimerNode_t *node).
+ * @brief  Closes the push sequence of a button when its wheel timer expires.
+ * @param  node Timeout node, its context is the Button_t.
+ * @return void
+ */
+static void Button_TimeoutCallback(softTimerNode_t *node) {
+	Button_t *button = (Button_t*) node->context;
+
+	/* a held button keeps its sequence open until released, and queued
+	 * edges may still belong to it: the poll closes it after their replay */
+	if (!BUTTON_IS_HELD(button)
+#if BUTTON_EXTI_ENABLE
+			&& button->edgeTail == button->edgeHead
+#endif
+			) {
+		button->isReadFinish = true;
+		BUTTON_STATS_INC(button, timeouts);
+	}
+}
+#endif /* BUTTON_TIMER_WHEEL_ENABLE */
+
+/*!
+ * @fn     static void Button_OpenHeld(Button_t *button, uint32_t now).
+ * @brief  Opens the next sequence with the press held while the last one
+ *         waited for its read.
+ * @param  button Pointer to the Button_t structure.
+ * @param  now Tick of the poll after the read, the new timeout starts here.
+ * @return void
+ */
+static void Button_OpenHeld(Button_t *button, uint32_t now) {
+	button->isPressHeld = false;
+	button->pushCount = 1;
+#if BUTTON_TIMER_WHEEL_ENABLE
+	softTimerWheel_start(buttonWheel, &button->timeoutNode, now,
+			BUTTON_TIMEOUT(button));
+#else
+	BUTTON_TIMER_RESET_AT(&button->timeoutTimer, now);
+#endif
+#if BUTTON_GESTURE_ENABLE
+	button->gesture = BUTTON_GESTURE_EMPTY;
+	if (button->lastState == BUTTON_ACTIVE_STATE(button)) {
+		return; /* its release appends the symbol */
+	}
+	button->gesture = ButtonGesture_Append(button->gesture,
+			(button->pressDuration >= BUTTON_GESTURE_LONG_MS) ?
+					BUTTON_GESTURE_LONG : BUTTON_GESTURE_SHORT);
+#endif
+#if BUTTON_EARLY_RESOLVE
+	if (button->pushCount >= BUTTON_MAX_COUNT(button)) {
+		Button_ResolveEarly(button);
+	}
+#endif
+}
+
+#if BUTTON_EARLY_RESOLVE
+/*!
+ * @fn     static void Button_ResolveEarly(Button_t *button).
+ * @brief  Closes a sequence that reached the max count, before its timeout.
+ * @param  button Pointer to the Button_t structure.
+ * @return void
+ */
+static void Button_ResolveEarly(Button_t *button) {
+	button->isReadFinish = true;
+#if BUTTON_TIMER_WHEEL_ENABLE
+	softTimerWheel_stop(&button->timeoutNode);
+#endif
+}
+#endif /* BUTTON_EARLY_RESOLVE */
+
 /************************ (C) COPYRIGHT [Your Company Name] *****END OF FILE****/
@@ -0,0 +1,223 @@
+/**
+ ******************************************************************************
+ * @file           : button_matrix.c
+ * @author         : KeyhanSalehi
+ * @brief          : Implementation of the Button Matrix (keypad) scanner.
+ ******************************************************************************
+ * @attention
+ *
+ * A scan pulls one row low with a single port write (releasing the previous
+ * row in the same write), reads the column port once and shifts the low
+ * columns into the row's lanes. The whole matrix then goes through one
+ * vertical counter update, and toggled lanes are counted through
+ * Button_RegisterPress and Button_RegisterRelease.
+ *
+ * Without a diode per key, three keys on the corners of a rectangle make the
+ * fourth appear pressed (ghosting).
+ *
+ ******************************************************************************
+ */
+
+/* Includes ------------------------------------------------------------------*/
+
+/* 1. System Header Files */
+
+/* 2. Project Header Files */
+
+/* 3. Module Header File */
+#include "button_matrix.h"
+
+/* Defines & Macros ----------------------------------------------------------*/
+/**
+ * @brief Constants and macros specific to this file.
+ */
+
+/* Typedefs ------------------------------------------------------------------*/
+/**
+ * @brief Typedefs for local use in this file.
+ */
+
+/* Variables -----------------------------------------------------------------*/
+
+/* 1. Global Variables */
+
+/* 2. Static Variables */
+
+/* Function Declarations -----------------------------------------------------*/
+
+/* 1. Local Prototype Functions */
+
+/*! @fn @private */
+static uint8_t ButtonMatrix_PinCount(uint16_t mask);
+
+/* 2. Global Function Declarations */
+
+/*!
+ * @fn     return_t ButtonMatrix_Init(ButtonMatrix_t *matrix, GPIO_TypeDef *rowPort, uint16_t rowMask, GPIO_TypeDef *colPort, uint16_t colMask).
+ * @brief  Initializes an empty matrix and releases all rows.
+ * @param  matrix Pointer to the ButtonMatrix_t structure.
+ * @param  rowPort GPIO port of the row pins.
+ * @param  rowMask Row pins.
+ * @param  colPort GPIO port of the column pins.
+ * @param  colMask Column pins, must be consecutive.
+ * @return return_t Returns return_success or return_failed.
+ */
+return_t ButtonMatrix_Init(ButtonMatrix_t *matrix, GPIO_TypeDef *rowPort,
+		uint16_t rowMask, GPIO_TypeDef *colPort, uint16_t colMask) {
+
+	/* Local variable & initial */
+	uint8_t shift = 0;
+	uint8_t colCount = ButtonMatrix_PinCount(colMask);
+
+	if (rowMask == 0U || colMask == 0U
+			|| (rowPort == colPort && (rowMask & colMask) != 0U)
+			|| ButtonMatrix_PinCount(rowMask) * colCount > BUTTON_MATRIX_MAX_KEYS) {
+		return return_failed;
+	}
+	while (((colMask >> shift) & 1U) == 0U) {
+		shift++;
+	}
+	/* consecutive columns shift straight into the lanes of a row */
+	if ((uint32_t) (colMask >> shift) != (1UL << colCount) - 1U) {
+		return return_failed;
+	}
+
+	memset(matrix, 0, sizeof(*matrix));
+	matrix->rowPort = rowPort;
+	matrix->rowMask = rowMask;
+	matrix->colPort = colPort;
+	matrix->colShift = shift;
+	matrix->colCount = colCount;
+	ButtonVCounter_init(&matrix->vcounter, 0U);
+	softTimer_reset(&matrix->sampleTimer);
+
+	BUTTON_MATRIX_DRIVE(rowPort, rowMask, 0U);
+
+	return return_success;
+}
+
+/*!
+ * @fn     return_t ButtonMatrix_Add(ButtonMatrix_t *matrix, Button_t *button, uint8_t row).
+ * @brief  Attaches a key, set up by Button_Init on its column pin.
+ * @param  matrix Pointer to the ButtonMatrix_t structure.
+ * @param  button Pointer to a Button_t initialized on the column port and pin.
+ * @param  row Row index of the key.
+ * @return return_t Returns return_success or return_failed.
+ */
+return_t ButtonMatrix_Add(ButtonMatrix_t *matrix, Button_t *button,
+		uint8_t row) {
+
+	/* Local variable & initial */
+	uint16_t pin = BUTTON_PIN(button);
+	uint8_t col = 0;
+	uint8_t lane;
+
+	if (BUTTON_PORT(button) != matrix->colPort || !BUTTON_IS_ACTIVE_LOW(button)
+			|| row >= ButtonMatrix_PinCount(matrix->rowMask)
+			|| pin == 0U || (pin & (pin - 1U)) != 0U) {
+		return return_failed;
+	}
+	while ((pin >> col) != 1U) {
+		col++;
+	}
+	if (col < matrix->colShift || col >= matrix->colShift + matrix->colCount) {
+		return return_failed;
+	}
+
+	lane = (uint8_t) (row * matrix->colCount + (col - matrix->colShift));
+	if ((matrix->keyMask & (1UL << lane)) != 0U) {
+		return return_failed;
+	}
+
+	matrix->keyMask |= 1UL << lane;
+	matrix->buttons[lane] = button;
+	button->source = BUTTON_SOURCE_EXTERNAL;
+	button->lastState = (GPIO_PinState) (BUTTON_ACTIVE_STATE(button) ^ GPIO_PIN_SET);
+
+	return return_success;
+}
+
+/*!
+ * @fn     void ButtonMatrix_Scan(ButtonMatrix_t *matrix).
+ * @brief  Scans all rows once per BUTTON_MATRIX_SAMPLE_MS and feeds the
+ *         debounced presses to the keys.
+ * @param  matrix Pointer to the ButtonMatrix_t structure.
+ * @return void
+ */
+void ButtonMatrix_Scan(ButtonMatrix_t *matrix) {
+	ButtonMatrix_ScanAt(matrix, SOFTTIMER_TICK());
+}
+
+/*!
+ * @fn     void ButtonMatrix_ScanAt(ButtonMatrix_t *matrix, uint32_t now).
+ * @brief  Same as ButtonMatrix_Scan, with the tick snapshot of the pass.
+ * @param  matrix Pointer to the ButtonMatrix_t structure.
+ * @param  now Tick read once for the whole pass.
+ * @return void
+ */
+void ButtonMatrix_ScanAt(ButtonMatrix_t *matrix, uint32_t now) {
+
+	/* Local variable & initial */
+	uint32_t colLanes = (1UL << matrix->colCount) - 1U;
+	uint32_t sample = 0;
+	uint32_t toggled;
+	uint32_t pressed;
+	uint32_t released;
+	uint16_t previous = 0;
+	uint8_t lane = 0;
+
+	/* counters assume a fixed sample rate */
+	if (!softTimer_isElapsedAt(&matrix->sampleTimer, now,
+			SOFTTIMER_MS_TO_TICKS(BUTTON_MATRIX_SAMPLE_MS))) {
+		return;
+	}
+	softTimer_resetAt(&matrix->sampleTimer, now);
+
+	for (uint16_t rows = matrix->rowMask; rows != 0U; rows &= rows - 1U) {
+		uint16_t row = rows & (uint16_t) -rows; /* lowest remaining row pin */
+
+		BUTTON_MATRIX_DRIVE(matrix->rowPort, previous, row);
+		BUTTON_MATRIX_SETTLE();
+		/* a pressed key pulls its column low */
+		sample |= ((~(uint32_t) BUTTON_READ_PORT(matrix->colPort)
+				>> matrix->colShift) & colLanes) << lane;
+		lane += matrix->colCount;
+		previous = row;
+	}
+	BUTTON_MATRIX_DRIVE(matrix->rowPort, previous, 0U);
+
+	toggled = ButtonVCounter_update(&matrix->vcounter, sample & matrix->keyMask);
+	pressed = toggled & matrix->vcounter.state;
+	released = toggled & ~matrix->vcounter.state;
+
+	for (lane = 0; (pressed | released) != 0U;
+			lane++, pressed >>= 1, released >>= 1) {
+		if ((pressed & 1U) != 0U) {
+			Button_RegisterPress(matrix->buttons[lane], now);
+		} else if ((released & 1U) != 0U) {
+			Button_RegisterRelease(matrix->buttons[lane], now);
+		}
+	}
+}
+
+/* 3. Local Function Declarations */
+
+/*!
+ * @fn     static uint8_t ButtonMatrix_PinCount(uint16_t mask).
+ * @brief  Counts the pins of a mask.
+ * @param  mask Pin mask.
+ * @return uint8_t Number of set bits.
+ */
+static uint8_t ButtonMatrix_PinCount(uint16_t mask) {
+
+	/* Local variable & initial */
+	uint8_t count = 0;
+
+	for (; mask != 0U; mask &= mask - 1U) {
+		count++;
+	}
+
+	return count;
+}
+
+/************************ (C) COPYRIGHT [KeyhanSalehi] *****END OF FILE****/
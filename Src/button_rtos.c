@@ -0,0 +1,194 @@
+/**
+ ******************************************************************************
+ * @file           : button_rtos.c
+ * @author         : KeyhanSalehi
+ * @brief          : Implementation of the FreeRTOS task adapter.
+ ******************************************************************************
+ * @attention
+ *
+ * Each pass of the task runs Button_ProcessAt on all buttons with one tick
+ * snapshot, forwards the events to the FreeRTOS queue and asks
+ * Button_NextDeadline how long it may sleep. The notification is a
+ * counting semaphore, so an edge arriving between the deadline check and
+ * ulTaskNotifyTake still wakes the task.
+ *
+ ******************************************************************************
+ */
+
+/* Includes ------------------------------------------------------------------*/
+
+/* 1. System Header Files */
+
+/* 2. Project Header Files */
+
+/* 3. Module Header File */
+#include "button_rtos.h"
+
+#if BUTTON_RTOS_ENABLE
+
+/* Defines & Macros ----------------------------------------------------------*/
+/**
+ * @brief Constants and macros specific to this file.
+ */
+
+/*! @def @brief events moved from the internal ring to the queue per batch. */
+#define BUTTON_RTOS_BATCH 4U
+
+/* Typedefs ------------------------------------------------------------------*/
+/**
+ * @brief Typedefs for local use in this file.
+ */
+
+/* Variables -----------------------------------------------------------------*/
+
+/* 1. Global Variables */
+
+/* 2. Static Variables */
+
+/* Function Declarations -----------------------------------------------------*/
+
+/* 1. Local Prototype Functions */
+
+/*! @fn @private */
+static void ButtonRtos_Task(void *argument);
+/*! @fn @private */
+static TickType_t ButtonRtos_Pass(ButtonRtos_t *rtos);
+
+/* 2. Global Function Declarations */
+
+/*!
+ * @fn     return_t ButtonRtos_Start(ButtonRtos_t *rtos, Button_t *buttons, size_t count, UBaseType_t priority).
+ * @brief  Creates the result queue and the task serving the buttons.
+ * @param  rtos Pointer to the ButtonRtos_t structure.
+ * @param  buttons Array of initialized buttons.
+ * @param  count Number of buttons in the array.
+ * @param  priority Priority of the button task.
+ * @return return_t Returns return_success or return_failed.
+ */
+return_t ButtonRtos_Start(ButtonRtos_t *rtos, Button_t *buttons, size_t count,
+		UBaseType_t priority) {
+
+	rtos->buttons = buttons;
+	rtos->count = count;
+	rtos->task = NULL;
+	rtos->dropped = 0;
+	ButtonEvent_Init(&rtos->events);
+	Button_SetEventQueue(&rtos->events);
+
+	rtos->queue = xQueueCreate(BUTTON_RTOS_QUEUE_LENGTH, sizeof(ButtonEvent_t));
+	if (rtos->queue == NULL) {
+		return return_failed;
+	}
+
+	if (xTaskCreate(ButtonRtos_Task, "buttons", BUTTON_RTOS_STACK_WORDS, rtos,
+			priority, &rtos->task) != pdPASS) {
+		vQueueDelete(rtos->queue);
+		rtos->queue = NULL;
+		return return_failed;
+	}
+
+	return return_success;
+}
+
+/*!
+ * @fn     return_t ButtonRtos_Receive(ButtonRtos_t *rtos, ButtonEvent_t *event, TickType_t wait).
+ * @brief  Takes the oldest result, blocking up to wait RTOS ticks.
+ * @param  rtos Pointer to the ButtonRtos_t structure.
+ * @param  event Pointer to store the event.
+ * @param  wait Ticks to block.
+ * @return return_t Returns return_success or return_busy.
+ */
+return_t ButtonRtos_Receive(ButtonRtos_t *rtos, ButtonEvent_t *event,
+		TickType_t wait) {
+	return (xQueueReceive(rtos->queue, event, wait) == pdPASS) ?
+			return_success : return_busy;
+}
+
+/*!
+ * @fn     void ButtonRtos_NotifyFromISR(ButtonRtos_t *rtos).
+ * @brief  Wakes the button task, call from an interrupt.
+ * @param  rtos Pointer to the ButtonRtos_t structure.
+ * @return void
+ */
+void ButtonRtos_NotifyFromISR(ButtonRtos_t *rtos) {
+
+	/* Local variable & initial */
+	BaseType_t woken = pdFALSE;
+
+	if (rtos->task != NULL) {
+		vTaskNotifyGiveFromISR(rtos->task, &woken);
+		portYIELD_FROM_ISR(woken);
+	}
+}
+
+#if BUTTON_EXTI_ENABLE
+/*!
+ * @fn     void ButtonRtos_EdgeFromISR(ButtonRtos_t *rtos, Button_t *button).
+ * @brief  Timestamps an EXTI edge of the button and wakes the task.
+ * @param  rtos Pointer to the ButtonRtos_t structure.
+ * @param  button Pointer to the Button_t structure.
+ * @return void
+ */
+void ButtonRtos_EdgeFromISR(ButtonRtos_t *rtos, Button_t *button) {
+	Button_EXTI_Callback(button);
+	ButtonRtos_NotifyFromISR(rtos);
+}
+#endif
+
+/* 3. Local Function Declarations */
+
+/*!
+ * @fn     static void ButtonRtos_Task(void *argument).
+ * @brief  Button task, sleeps until a notification or the next deadline.
+ * @param  argument Pointer to the ButtonRtos_t structure.
+ * @return void
+ */
+static void ButtonRtos_Task(void *argument) {
+
+	/* Local variable & initial */
+	ButtonRtos_t *rtos = (ButtonRtos_t*) argument;
+
+	for (;;) {
+		(void) ulTaskNotifyTake(pdTRUE, ButtonRtos_Pass(rtos));
+	}
+}
+
+/*!
+ * @fn     static TickType_t ButtonRtos_Pass(ButtonRtos_t *rtos).
+ * @brief  Runs the engine once and forwards its events to the queue.
+ * @param  rtos Pointer to the ButtonRtos_t structure.
+ * @return TickType_t RTOS ticks the task may sleep.
+ */
+static TickType_t ButtonRtos_Pass(ButtonRtos_t *rtos) {
+
+	/* Local variable & initial */
+	uint32_t now = SOFTTIMER_TICK();
+	uint32_t deadline = 0;
+	ButtonEvent_t events[BUTTON_RTOS_BATCH];
+	size_t count;
+
+	for (size_t i = 0; i < rtos->count; i++) {
+		Button_ProcessAt(&rtos->buttons[i], now);
+	}
+
+	while ((count = ButtonEvent_PopBatch(&rtos->events, events,
+			BUTTON_RTOS_BATCH)) != 0U) {
+		for (size_t i = 0; i < count; i++) {
+			if (xQueueSend(rtos->queue, &events[i], 0) != pdPASS) {
+				rtos->dropped++;
+			}
+		}
+	}
+
+	if (!Button_NextDeadline(rtos->buttons, rtos->count, now, &deadline)) {
+		return BUTTON_RTOS_IDLE_WAIT;
+	}
+
+	/* one tick more so the deadline has surely passed on wakeup */
+	return (deadline == now) ?
+			0U : pdMS_TO_TICKS(SOFTTIMER_TICKS_TO_MS(deadline - now)) + 1U;
+}
+
+#endif /* BUTTON_RTOS_ENABLE */
+
+/************************ (C) COPYRIGHT [KeyhanSalehi] *****END OF FILE****/
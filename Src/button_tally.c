@@ -0,0 +1,189 @@
+/**
+ ******************************************************************************
+ * @file           : button_tally.c
+ * @author         : KeyhanSalehi
+ * @brief          : Implementation of the packed click tally of a bank port.
+ ******************************************************************************
+ * @attention
+ *
+ * New presses come from the debounced pressed mask of the port, so the
+ * tally's only per-pin state is its count field. The timeout restarts on
+ * any press or release of the port, which keeps one timer for all pins.
+ *
+ ******************************************************************************
+ */
+
+/* Includes ------------------------------------------------------------------*/
+
+/* 1. System Header Files */
+
+/* 2. Project Header Files */
+#include "button_event.h"
+
+/* 3. Module Header File */
+#include "button_tally.h"
+
+/* Defines & Macros ----------------------------------------------------------*/
+/**
+ * @brief Constants and macros specific to this file.
+ */
+
+/* Typedefs ------------------------------------------------------------------*/
+/**
+ * @brief Typedefs for local use in this file.
+ */
+
+/* Variables -----------------------------------------------------------------*/
+
+/* 1. Global Variables */
+
+/* 2. Static Variables */
+
+/* Function Declarations -----------------------------------------------------*/
+
+/* 1. Local Prototype Functions */
+
+/*! @fn @private */
+static void ButtonTally_Increment(ButtonTally_t *tally, uint8_t bit);
+/*! @fn @private */
+static bool ButtonTally_IsCounting(const ButtonTally_t *tally);
+
+/* 2. Global Function Declarations */
+
+/*!
+ * @fn     void ButtonTally_Init(ButtonTally_t *tally, ButtonBankPort_t *bankPort, uint8_t maxCount, uint8_t idBase).
+ * @brief  Initializes the tally of a bank port.
+ * @param  tally Pointer to the ButtonTally_t structure.
+ * @param  bankPort Pointer to the port slot.
+ * @param  maxCount Highest valid count.
+ * @param  idBase Event id of pin 0.
+ * @return void
+ */
+void ButtonTally_Init(ButtonTally_t *tally, ButtonBankPort_t *bankPort,
+		uint8_t maxCount, uint8_t idBase) {
+	memset(tally, 0, sizeof(*tally));
+	tally->bankPort = bankPort;
+	tally->maxCount = (maxCount > BUTTON_TALLY_MAX_COUNT) ?
+			BUTTON_TALLY_MAX_COUNT : maxCount;
+	tally->idBase = idBase;
+	tally->lastPressed = ButtonBank_Pressed(bankPort);
+}
+
+/*!
+ * @fn     size_t ButtonTally_Update(ButtonTally_t *tally, uint32_t now, ButtonResult_t *results).
+ * @brief  Counts the new presses of the last scan and closes idle sequences.
+ * @param  tally Pointer to the ButtonTally_t structure.
+ * @param  now Tick of the pass.
+ * @param  results Array for the closed counts, or NULL.
+ * @return size_t Number of valid counts closed by this call.
+ */
+size_t ButtonTally_Update(ButtonTally_t *tally, uint32_t now,
+		ButtonResult_t *results) {
+
+	/* Local variable & initial */
+	uint16_t pressed = ButtonBank_Pressed(tally->bankPort);
+	uint16_t newPresses = (uint16_t) (pressed & ~tally->lastPressed);
+	bool isChanged = (pressed != tally->lastPressed);
+	ButtonEventQueue_t *queue = Button_GetEventQueue();
+	size_t closed = 0;
+
+	tally->lastPressed = pressed;
+
+	if (isChanged) {
+		softTimer_resetAt(&tally->timeoutTimer, now);
+		for (uint8_t bit = 0; newPresses != 0U; bit++, newPresses >>= 1) {
+			if ((newPresses & 1U) != 0U) {
+				ButtonTally_Increment(tally, bit);
+			}
+		}
+		return 0;
+	}
+
+	/* a held pin keeps the sequences of its port open */
+	if (pressed != 0U || !ButtonTally_IsCounting(tally)
+			|| !softTimer_isElapsedAt(&tally->timeoutTimer, now,
+					SOFTTIMER_MS_TO_TICKS(BUTTON_TIMEOUT_MS))) {
+		return 0;
+	}
+
+	for (uint8_t bit = 0; bit < BUTTON_BANK_PORT_PINS; bit++) {
+		uint8_t count = ButtonTally_Count(tally, bit);
+
+		if (count == 0U || count > tally->maxCount) {
+			continue;
+		}
+
+		if (results != NULL) {
+			results[closed].index = bit;
+			results[closed].id = (uint8_t) (tally->idBase + bit);
+			results[closed].count = count;
+		}
+		if (queue != NULL) {
+			ButtonEvent_t event = {
+					.timestamp = now,
+					.duration = 0U,
+					.id = (uint8_t) (tally->idBase + bit),
+					.type = (uint8_t) BUTTON_EVENT_CLICKS,
+					.count = count };
+
+			(void) ButtonEvent_Push(queue, &event);
+		}
+		closed++;
+	}
+
+	memset(tally->counts, 0, sizeof(tally->counts));
+	return closed;
+}
+
+/* 3. Local Function Declarations */
+
+/*!
+ * @fn     static void ButtonTally_Increment(ButtonTally_t *tally, uint8_t bit).
+ * @brief  Adds a press to the count field of a pin.
+ * @param  tally Pointer to the ButtonTally_t structure.
+ * @param  bit Pin bit number.
+ * @return void
+ */
+static void ButtonTally_Increment(ButtonTally_t *tally, uint8_t bit) {
+
+	/* Local variable & initial */
+	uint32_t *word = &tally->counts[bit / BUTTON_TALLY_PER_WORD];
+	uint32_t shift = (bit % BUTTON_TALLY_PER_WORD) * BUTTON_TALLY_BITS;
+	uint8_t count = ButtonTally_Count(tally, bit);
+
+#if BUTTON_OVERFLOW_POLICY == BUTTON_OVERFLOW_SATURATE
+	if (count >= tally->maxCount) {
+		return;
+	}
+	count++;
+#elif BUTTON_OVERFLOW_POLICY == BUTTON_OVERFLOW_WRAP
+	count = (count >= tally->maxCount) ? 1U : (uint8_t) (count + 1U);
+#else
+	/* max count + 1 marks the failed sequence until it closes */
+	if (count > tally->maxCount) {
+		return;
+	}
+	count++;
+#endif
+
+	*word = (*word & ~(BUTTON_TALLY_FIELD << shift)) | ((uint32_t) count << shift);
+}
+
+/*!
+ * @fn     static bool ButtonTally_IsCounting(const ButtonTally_t *tally).
+ * @brief  Checks whether any pin has a sequence in progress.
+ * @param  tally Pointer to the ButtonTally_t structure.
+ * @return bool true if a count is not zero.
+ */
+static bool ButtonTally_IsCounting(const ButtonTally_t *tally) {
+
+	for (size_t i = 0; i < BUTTON_TALLY_WORDS; i++) {
+		if (tally->counts[i] != 0U) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+/************************ (C) COPYRIGHT [KeyhanSalehi] *****END OF FILE****/
@@ -0,0 +1,367 @@
+/**
+ ******************************************************************************
+ * @file           : button_trace.c
+ * @author         : KeyhanSalehi
+ * @brief          : Implementation of the button edge trace recorder.
+ ******************************************************************************
+ * @attention
+ *
+ * Recording an edge is a subtraction and one 16-bit store, so it can stay
+ * enabled in the field without changing Button_CountPushes timing. A gap of
+ * 0x7FFF ticks or more is written as time-only records 0x7FFF, each
+ * followed by a word holding a multiple of 0x7FFF ticks; the edge record
+ * then carries the remainder, which can never be mistaken for a time-only
+ * record.
+ *
+ ******************************************************************************
+ */
+
+/* Includes ------------------------------------------------------------------*/
+
+/* 1. System Header Files */
+#if defined(HOST_SIM) && HOST_SIM
+#include <stdlib.h>
+#endif
+
+/* 2. Project Header Files */
+
+/* 3. Module Header File */
+#include "button_trace.h"
+
+#if BUTTON_TRACE_ENABLE
+
+/* Defines & Macros ----------------------------------------------------------*/
+/**
+ * @brief Constants and macros specific to this file.
+ */
+
+/*! @def @brief ring index of a free-running record counter. */
+#define BUTTON_TRACE_INDEX(count) ((count) & (BUTTON_TRACE_SIZE - 1U))
+
+/*! @def @brief records written per dump line. */
+#define BUTTON_TRACE_LINE_RECORDS 16U
+
+/* Typedefs ------------------------------------------------------------------*/
+/**
+ * @brief Typedefs for local use in this file.
+ */
+
+/* Variables -----------------------------------------------------------------*/
+
+/* 1. Global Variables */
+
+/* 2. Static Variables */
+
+/*! @brief hex digits of the dump. */
+static const char traceHex[] = "0123456789ABCDEF";
+
+/* Function Declarations -----------------------------------------------------*/
+
+/* 1. Local Prototype Functions */
+
+/*! @fn @private */
+static size_t ButtonTrace_FormatNumber(char *text, uint32_t value);
+#if defined(HOST_SIM) && HOST_SIM
+/*! @fn @private */
+static void ButtonTrace_Poll(Button_t *button, ButtonTraceResult_t result);
+/*! @fn @private */
+static void ButtonTrace_RunFor(Button_t *button, uint32_t ticks,
+		ButtonTraceResult_t result);
+#endif
+
+/* 2. Global Function Declarations */
+
+/*!
+ * @fn     void ButtonTrace_Attach(ButtonTrace_t *trace, Button_t *button).
+ * @brief  Clears a trace and starts recording the edges of a button into it.
+ * @param  trace Pointer to the ButtonTrace_t structure.
+ * @param  button Pointer to an initialized Button_t (polled or EXTI).
+ * @return void
+ */
+void ButtonTrace_Attach(ButtonTrace_t *trace, Button_t *button) {
+	trace->head = 0;
+	trace->lastTick = SOFTTIMER_TICK();
+	trace->lastLevel = (uint8_t) button->lastState;
+	trace->id = button->id;
+	button->trace = trace;
+}
+
+/*!
+ * @fn     void ButtonTrace_Detach(Button_t *button).
+ * @brief  Stops recording a button, its trace keeps the records.
+ * @param  button Pointer to the Button_t structure.
+ * @return void
+ */
+void ButtonTrace_Detach(Button_t *button) {
+	button->trace = NULL;
+}
+
+/*!
+ * @fn     void ButtonTrace_Record(ButtonTrace_t *trace, uint32_t tick, uint8_t level).
+ * @brief  Appends one edge, called by the button engine.
+ * @param  trace Pointer to the ButtonTrace_t structure.
+ * @param  tick Tick of the edge.
+ * @param  level Pin level after the edge (GPIO_PinState).
+ * @return void
+ */
+void ButtonTrace_Record(ButtonTrace_t *trace, uint32_t tick, uint8_t level) {
+
+	/* Local variable & initial */
+	uint32_t delta = tick - trace->lastTick;
+	uint32_t head = trace->head;
+
+	if (delta >= BUTTON_TRACE_SKIP) {
+		/* long idle gap (rare, the division is fine): time-only records */
+		uint16_t skip = (uint16_t) (BUTTON_TRACE_SKIP
+				| ((trace->lastLevel != 0U) ? BUTTON_TRACE_LEVEL : 0U));
+		uint32_t units = delta / BUTTON_TRACE_SKIP;
+
+		delta %= BUTTON_TRACE_SKIP;
+		while (units != 0U) {
+			uint32_t chunk = (units > BUTTON_TRACE_UNITS_MAX) ?
+					BUTTON_TRACE_UNITS_MAX : units;
+
+			trace->records[BUTTON_TRACE_INDEX(head)] = skip;
+			trace->records[BUTTON_TRACE_INDEX(head + 1U)] = (uint16_t) chunk;
+			head += 2U;
+			units -= chunk;
+		}
+	}
+	trace->records[BUTTON_TRACE_INDEX(head)] = (uint16_t) (delta
+			| ((level != 0U) ? BUTTON_TRACE_LEVEL : 0U));
+	trace->head = head + 1U; /* publish the record after it is written */
+	trace->lastTick = tick;
+	trace->lastLevel = level;
+}
+
+/*!
+ * @fn     size_t ButtonTrace_Count(const ButtonTrace_t *trace).
+ * @brief  Gets the number of records held by a trace.
+ * @param  trace Pointer to the ButtonTrace_t structure.
+ * @return size_t Records available, at most BUTTON_TRACE_SIZE.
+ */
+size_t ButtonTrace_Count(const ButtonTrace_t *trace) {
+
+	/* Local variable & initial */
+	uint32_t head = trace->head;
+
+	return (head < BUTTON_TRACE_SIZE) ? head : BUTTON_TRACE_SIZE;
+}
+
+/*!
+ * @fn     void ButtonTrace_Dump(const ButtonTrace_t *trace, ButtonTraceWrite_t write).
+ * @brief  Writes the records of a trace as text, oldest first.
+ * @param  trace Pointer to the ButtonTrace_t structure.
+ * @param  write Output function (UART, SWO...).
+ * @return void
+ */
+void ButtonTrace_Dump(const ButtonTrace_t *trace, ButtonTraceWrite_t write) {
+
+	/* Local variable & initial */
+	char line[BUTTON_TRACE_LINE_RECORDS * 5U + 2U];
+	size_t length = 0;
+	uint32_t count = (uint32_t) ButtonTrace_Count(trace);
+	uint32_t first = trace->head - count;
+
+	/* a wrapped ring may start on the orphaned word of a time-only record,
+	 * and a first edge's delta is from an overwritten record anyway */
+	if (trace->head > BUTTON_TRACE_SIZE
+			&& (trace->records[BUTTON_TRACE_INDEX(first)] & BUTTON_TRACE_DELTA)
+					!= BUTTON_TRACE_SKIP) {
+		first++;
+		count--;
+	}
+
+	/* header: "BTRACE <version> <id> <count>" */
+	memcpy(line, "BTRACE ", 7U);
+	length = 7U;
+	length += ButtonTrace_FormatNumber(&line[length], BUTTON_TRACE_VERSION);
+	line[length++] = ' ';
+	length += ButtonTrace_FormatNumber(&line[length], trace->id);
+	line[length++] = ' ';
+	length += ButtonTrace_FormatNumber(&line[length], count);
+	line[length++] = '\r';
+	line[length++] = '\n';
+	write(line, length);
+
+	length = 0;
+	for (uint32_t i = 0; i < count; i++) {
+		uint16_t record = trace->records[BUTTON_TRACE_INDEX(first + i)];
+
+		line[length++] = traceHex[(record >> 12) & 0xFU];
+		line[length++] = traceHex[(record >> 8) & 0xFU];
+		line[length++] = traceHex[(record >> 4) & 0xFU];
+		line[length++] = traceHex[record & 0xFU];
+		line[length++] = ' ';
+		if ((i + 1U) % BUTTON_TRACE_LINE_RECORDS == 0U || i + 1U == count) {
+			line[length - 1U] = '\r';
+			line[length++] = '\n';
+			write(line, length);
+			length = 0;
+		}
+	}
+	write("END\r\n", 5U);
+}
+
+#if defined(HOST_SIM) && HOST_SIM
+/*!
+ * @fn     size_t ButtonTrace_Load(const char *text, uint16_t *records, size_t maxRecords, uint8_t *id).
+ * @brief  Parses a dump written by ButtonTrace_Dump.
+ * @param  text Dump text, NUL terminated.
+ * @param  records Array receiving the records.
+ * @param  maxRecords Capacity of records.
+ * @param  id Pointer to store the button id of the dump.
+ * @return size_t Number of records loaded, 0 if no dump was found.
+ */
+size_t ButtonTrace_Load(const char *text, uint16_t *records, size_t maxRecords,
+		uint8_t *id) {
+
+	/* Local variable & initial */
+	const char *cursor = strstr(text, "BTRACE ");
+	char *end = NULL;
+	unsigned long count = 0;
+	size_t loaded = 0;
+
+	if (cursor == NULL) {
+		return 0;
+	}
+	cursor += 7;
+	if (strtoul(cursor, &end, 10) != BUTTON_TRACE_VERSION) {
+		return 0;
+	}
+	*id = (uint8_t) strtoul(end, &end, 10);
+	count = strtoul(end, &end, 10);
+
+	while (loaded < count && loaded < maxRecords) {
+		char *next = NULL;
+		unsigned long record = strtoul(end, &next, 16);
+
+		if (next == end) {
+			break; /* "END" or truncated dump */
+		}
+		records[loaded++] = (uint16_t) record;
+		end = next;
+	}
+
+	return loaded;
+}
+
+/*!
+ * @fn     void ButtonTrace_Replay(Button_t *button, const uint16_t *records, size_t count, ButtonTraceResult_t result).
+ * @brief  Drives a button's simulated pin with a trace and polls it every tick.
+ * @param  button Pointer to a polled Button_t on a simulated port.
+ * @param  records Records of the trace.
+ * @param  count Number of records.
+ * @param  result Called with every valid count Button_GetFinalCount reports.
+ * @return void
+ */
+void ButtonTrace_Replay(Button_t *button, const uint16_t *records, size_t count,
+		ButtonTraceResult_t result) {
+
+	/* Local variable & initial */
+	uint32_t gap = 0;
+
+	for (size_t i = 0; i < count; i++) {
+		uint32_t delta = records[i] & BUTTON_TRACE_DELTA;
+
+		if (delta == BUTTON_TRACE_SKIP) {
+			if (i + 1U < count) {
+				gap += (uint32_t) records[++i] * BUTTON_TRACE_SKIP;
+			}
+			continue;
+		}
+		gap += delta;
+
+		/* poll up to the edge, then apply it before the poll of its tick */
+		if (gap > 0U) {
+			ButtonTrace_RunFor(button, gap - 1U, result);
+			HostSim_Advance(1U);
+		}
+		HostSim_SetPin(BUTTON_PORT(button), BUTTON_PIN(button),
+				((records[i] & BUTTON_TRACE_LEVEL) != 0U) ?
+						GPIO_PIN_SET : GPIO_PIN_RESET);
+#if BUTTON_EXTI_ENABLE
+		if (button->source == BUTTON_SOURCE_EXTI) {
+			Button_EXTI_Callback(button);
+		}
+#endif
+		if (gap > 0U) {
+			ButtonTrace_Poll(button, result);
+		}
+		gap = 0;
+	}
+
+	/* let the last sequence close */
+	ButtonTrace_RunFor(button, BUTTON_TIMEOUT(button) + 1U, result);
+}
+#endif /* HOST_SIM */
+
+/* 3. Local Function Declarations */
+
+/*!
+ * @fn     static size_t ButtonTrace_FormatNumber(char *text, uint32_t value).
+ * @brief  Writes a number in decimal, without terminator.
+ * @param  text Destination, room for 10 digits.
+ * @param  value Number to write.
+ * @return size_t Number of digits written.
+ */
+static size_t ButtonTrace_FormatNumber(char *text, uint32_t value) {
+
+	/* Local variable & initial */
+	char digits[10];
+	size_t count = 0;
+
+	do {
+		digits[count++] = (char) ('0' + (value % 10U));
+		value /= 10U;
+	} while (value != 0U);
+
+	for (size_t i = 0; i < count; i++) {
+		text[i] = digits[count - 1U - i];
+	}
+
+	return count;
+}
+
+#if defined(HOST_SIM) && HOST_SIM
+/*!
+ * @fn     static void ButtonTrace_Poll(Button_t *button, ButtonTraceResult_t result).
+ * @brief  Polls the button once and reports a valid count.
+ * @param  button Pointer to the Button_t structure.
+ * @param  result Result callback, may be NULL.
+ * @return void
+ */
+static void ButtonTrace_Poll(Button_t *button, ButtonTraceResult_t result) {
+
+	/* Local variable & initial */
+	uint8_t count = 0;
+
+#if BUTTON_TIMER_WHEEL_ENABLE
+	/* as a main loop does, expire the timeouts before the poll */
+	softTimerWheel_process(Button_GetTimerWheel(), HAL_GetTick());
+#endif
+	if (Button_GetFinalCount(button, &count) == return_success && result != NULL) {
+		result(HAL_GetTick(), count);
+	}
+}
+
+/*!
+ * @fn     static void ButtonTrace_RunFor(Button_t *button, uint32_t ticks, ButtonTraceResult_t result).
+ * @brief  Advances the virtual clock tick by tick, polling the button every tick.
+ * @param  button Pointer to the Button_t structure.
+ * @param  ticks Number of ticks to run.
+ * @param  result Result callback, may be NULL.
+ * @return void
+ */
+static void ButtonTrace_RunFor(Button_t *button, uint32_t ticks,
+		ButtonTraceResult_t result) {
+	for (uint32_t i = 0; i < ticks; i++) {
+		HostSim_Advance(1U);
+		ButtonTrace_Poll(button, result);
+	}
+}
+#endif /* HOST_SIM */
+
+#endif /* BUTTON_TRACE_ENABLE */
+
+/************************ (C) COPYRIGHT [KeyhanSalehi] *****END OF FILE****/
@@ -0,0 +1,137 @@
+/**
+ ******************************************************************************
+ * @file           : host_sim.c
+ * @author         : KeyhanSalehi
+ * @brief          : Fake HAL for host (x86) builds of the Button Handler.
+ ******************************************************************************
+ * @attention
+ *
+ * Built only with HOST_SIM defined to 1, in place of the STM32 HAL.
+ *
+ ******************************************************************************
+ */
+
+/* Includes ------------------------------------------------------------------*/
+
+/* 1. System Header Files */
+#include <string.h>
+
+/* 2. Project Header Files */
+
+/* 3. Module Header File */
+#include "host_sim.h"
+
+#if defined(HOST_SIM) && HOST_SIM
+
+/* Variables -----------------------------------------------------------------*/
+
+/* 1. Global Variables */
+
+/*! @brief simulated GPIO ports. */
+GPIO_TypeDef hostSimPorts[HOST_SIM_PORTS];
+
+/* 2. Static Variables */
+
+/*! @brief virtual clock returned by HAL_GetTick. */
+static uint32_t hostSimTick = 0;
+
+/* Function Declarations -----------------------------------------------------*/
+
+/* 2. Global Function Declarations */
+
+/*!
+ * @fn     uint32_t HAL_GetTick(void).
+ * @brief  Gets the virtual clock.
+ * @return uint32_t Current virtual tick in ms.
+ */
+uint32_t HAL_GetTick(void) {
+	return hostSimTick;
+}
+
+/*!
+ * @fn     GPIO_PinState HAL_GPIO_ReadPin(GPIO_TypeDef *port, uint16_t pin).
+ * @brief  Reads a pin of a simulated port.
+ * @param  port GPIO port.
+ * @param  pin GPIO pin.
+ * @return GPIO_PinState Level of the pin in IDR.
+ */
+GPIO_PinState HAL_GPIO_ReadPin(GPIO_TypeDef *port, uint16_t pin) {
+	return ((port->IDR & pin) != 0U) ? GPIO_PIN_SET : GPIO_PIN_RESET;
+}
+
+/*!
+ * @fn     void HAL_GPIO_WritePin(GPIO_TypeDef *port, uint16_t pin, GPIO_PinState state).
+ * @brief  Writes a pin of a simulated port.
+ * @param  port GPIO port.
+ * @param  pin GPIO pin.
+ * @param  state Level to write to ODR.
+ * @return void
+ */
+void HAL_GPIO_WritePin(GPIO_TypeDef *port, uint16_t pin, GPIO_PinState state) {
+	if (state == GPIO_PIN_SET) {
+		port->ODR |= pin;
+	} else {
+		port->ODR &= ~(uint32_t) pin;
+	}
+}
+
+/*!
+ * @fn     void HostSim_Reset(void).
+ * @brief  Clears every simulated port and sets the virtual clock to 0.
+ * @return void
+ */
+void HostSim_Reset(void) {
+	memset(hostSimPorts, 0, sizeof(hostSimPorts));
+	hostSimTick = 0;
+}
+
+/*!
+ * @fn     void HostSim_SetTick(uint32_t tick).
+ * @brief  Sets the virtual clock.
+ * @param  tick New virtual tick in ms.
+ * @return void
+ */
+void HostSim_SetTick(uint32_t tick) {
+	hostSimTick = tick;
+}
+
+/*!
+ * @fn     void HostSim_Advance(uint32_t ms).
+ * @brief  Moves the virtual clock forward.
+ * @param  ms Number of ms to add.
+ * @return void
+ */
+void HostSim_Advance(uint32_t ms) {
+	hostSimTick += ms;
+}
+
+/*!
+ * @fn     void HostSim_SetPin(GPIO_TypeDef *port, uint16_t pin, GPIO_PinState state).
+ * @brief  Drives the input level of a simulated pin.
+ * @param  port GPIO port.
+ * @param  pin GPIO pin mask.
+ * @param  state Level to apply to IDR.
+ * @return void
+ */
+void HostSim_SetPin(GPIO_TypeDef *port, uint16_t pin, GPIO_PinState state) {
+	if (state == GPIO_PIN_SET) {
+		port->IDR |= pin;
+	} else {
+		port->IDR &= ~(uint32_t) pin;
+	}
+}
+
+/*!
+ * @fn     void HostSim_SetPort(GPIO_TypeDef *port, uint16_t levels).
+ * @brief  Drives the input levels of a whole simulated port.
+ * @param  port GPIO port.
+ * @param  levels New IDR value.
+ * @return void
+ */
+void HostSim_SetPort(GPIO_TypeDef *port, uint16_t levels) {
+	port->IDR = levels;
+}
+
+#endif /* HOST_SIM */
+
+/************************ (C) COPYRIGHT [KeyhanSalehi] *****END OF FILE****/
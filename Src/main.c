@@ -22,6 +22,8 @@
 /* Private includes ----------------------------------------------------------*/
 /* USER CODE BEGIN Includes */
 #include "button_handler.h"
+#include "button_dispatch.h"
+#include "button_bench.h"
 /* USER CODE END Includes */
 
 /* Private typedef -----------------------------------------------------------*/
@@ -31,6 +33,8 @@
 
 /* Private define ------------------------------------------------------------*/
 /* USER CODE BEGIN PD */
+/* id of the key, index of its callback table */
+#define KEY_ID 0U
 
 /* USER CODE END PD */
 
@@ -43,18 +47,35 @@
 
 /* USER CODE BEGIN PV */
 Button_t key = { 0 };
-uint8_t keyVal = 0;
+static ButtonEventQueue_t keyEvents;
+static ButtonDispatch_t keyDispatch;
+#if BUTTON_BENCH_ENABLE
+/* ports the benchmark spreads its buttons on, 16 per port */
+static GPIO_TypeDef *const benchPorts[] = { GPIOA, GPIOB, GPIOC,
+#if defined(GPIOD)
+		GPIOD,
+#endif
+		};
+#endif
 /* USER CODE END PV */
 
 /* Private function prototypes -----------------------------------------------*/
 void SystemClock_Config(void);
 static void MX_GPIO_Init(void);
 /* USER CODE BEGIN PFP */
+static void Key_OnClick(const ButtonEvent_t *event);
+static void Key_OnDoubleClick(const ButtonEvent_t *event);
+static void Key_OnTripleClick(const ButtonEvent_t *event);
 
 /* USER CODE END PFP */
 
 /* Private user code ---------------------------------------------------------*/
 /* USER CODE BEGIN 0 */
+/* callbacks of the key by click count, in flash */
+static const ButtonCallbacks_t keyCallbacks = {
+		.onClicks = { [1] = Key_OnClick, [2] = Key_OnDoubleClick,
+				[3] = Key_OnTripleClick, }, };
+static const ButtonCallbacks_t *const keyTables[] = { [KEY_ID] = &keyCallbacks, };
 
 /* USER CODE END 0 */
 
@@ -88,7 +109,17 @@ int main(void) {
 	MX_GPIO_Init();
 	/* USER CODE BEGIN 2 */
 
+#if BUTTON_BENCH_ENABLE
+	/* prints the cycle report once, retarget printf to SWO or a UART */
+	ButtonBench_Run(benchPorts, sizeof(benchPorts) / sizeof(benchPorts[0]));
+#endif
+
 	Button_Init(&key, KEY_GPIO_Port, KEY_Pin, GPIO_PULLUP);
+	Button_SetId(&key, KEY_ID);
+	ButtonEvent_Init(&keyEvents);
+	Button_SetEventQueue(&keyEvents);
+	ButtonDispatch_Init(&keyDispatch, &keyEvents, keyTables,
+			sizeof(keyTables) / sizeof(keyTables[0]));
 
 	/* USER CODE END 2 */
 
@@ -96,18 +127,9 @@ int main(void) {
 	/* USER CODE BEGIN WHILE */
 	while (1) {
 
-		/* Check button status */
-		if (Button_GetFinalCount(&key, &keyVal) == return_success) {
-			if (keyVal == 1) {
-				keyVal = 0;
-			} else if (keyVal == 2) {
-				keyVal = 0;
-			} else if (keyVal == 3) {
-				keyVal = 0;
-			} else if (keyVal == 4) {
-				keyVal = 0;
-			}
-		}
+		/* Run the button and its callbacks */
+		Button_Process(&key);
+		(void) ButtonDispatch_Run(&keyDispatch);
 
 		/* USER CODE END WHILE */
 
@@ -184,6 +206,35 @@ static void MX_GPIO_Init(void) {
 }
 
 /* USER CODE BEGIN 4 */
+/**
+ * @brief  Single click: toggles the LED.
+ * @param  event Clicks event of the key.
+ * @retval None
+ */
+static void Key_OnClick(const ButtonEvent_t *event) {
+	(void) event;
+	HAL_GPIO_TogglePin(led_GPIO_Port, led_Pin);
+}
+
+/**
+ * @brief  Double click: turns the LED on.
+ * @param  event Clicks event of the key.
+ * @retval None
+ */
+static void Key_OnDoubleClick(const ButtonEvent_t *event) {
+	(void) event;
+	HAL_GPIO_WritePin(led_GPIO_Port, led_Pin, GPIO_PIN_SET);
+}
+
+/**
+ * @brief  Triple click: turns the LED off.
+ * @param  event Clicks event of the key.
+ * @retval None
+ */
+static void Key_OnTripleClick(const ButtonEvent_t *event) {
+	(void) event;
+	HAL_GPIO_WritePin(led_GPIO_Port, led_Pin, GPIO_PIN_RESET);
+}
 
 /* USER CODE END 4 */
 
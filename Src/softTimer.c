@@ -0,0 +1,225 @@
+/**
+ *******************************************************************************
+ * @file           : softTimer.c
+ * @author         : Keyhan Salehi
+ * @brief          : Hashed timer wheel for the software timer library
+ *******************************************************************************
+ * @attention
+ *
+ * Timers are hashed into SOFTTIMER_WHEEL_SLOTS slots by their deadline and
+ * every processed tick only walks its own slot. Timers further away than one
+ * revolution simply stay in their slot until their deadline comes around.
+ *
+ *******************************************************************************
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "softTimer.h"
+
+/* Defines & Macros ----------------------------------------------------------*/
+
+/**
+ * @brief Slot index of a deadline
+ */
+#define SOFTTIMER_WHEEL_SLOT(tick)   ((tick) & (SOFTTIMER_WHEEL_SLOTS - 1U))
+
+/* Private Variables ---------------------------------------------------------*/
+
+static uint32_t softTimerLastTick = 0;  /*!< Last tick seen by softTimer_tick64() */
+static uint32_t softTimerWraps = 0;     /*!< Wraps of the 32-bit tick so far */
+
+/* Private Functions ---------------------------------------------------------*/
+
+/**
+ * @fn    static void softTimerWheel_expireSlot(softTimerWheel_t*, uint32_t, uint32_t)
+ * @brief Run the callbacks of every timer of a slot due at tick now
+ * @param wheel Pointer to timer wheel
+ * @param slot  Slot index
+ * @param now   Tick the deadlines are compared with
+ */
+static void softTimerWheel_expireSlot(softTimerWheel_t *wheel, uint32_t slot,
+        uint32_t now)
+{
+    softTimerNode_t *expired = NULL;
+    softTimerNode_t **link = &wheel->slots[slot];
+
+    /* unlink first, so callbacks are free to restart their own node */
+    while (*link != NULL) {
+        softTimerNode_t *node = *link;
+
+        if ((int32_t)(now - node->deadline) >= 0) {
+            *link = node->next;
+            if (node->next != NULL) {
+                node->next->pprev = link;
+            }
+            node->pprev = NULL;
+            node->next = expired;
+            expired = node;
+        } else {
+            link = &node->next;
+        }
+    }
+
+    while (expired != NULL) {
+        softTimerNode_t *node = expired;
+
+        expired = node->next;
+        node->next = NULL;
+        if (node->callback != NULL) {
+            node->callback(node);
+        }
+    }
+}
+
+/* Exported Functions --------------------------------------------------------*/
+
+/**
+ * @fn    uint64_t softTimer_tick64(void)
+ * @brief Monotonic 64-bit tick extended from SOFTTIMER_TICK()
+ * @return Ticks since startup, never wraps
+ */
+uint64_t softTimer_tick64(void)
+{
+    uint32_t tick = SOFTTIMER_TICK();
+
+    if (tick < softTimerLastTick) {
+        softTimerWraps++;
+    }
+    softTimerLastTick = tick;
+
+    return ((uint64_t)softTimerWraps << 32) | tick;
+}
+
+/**
+ * @fn    void softTimerWheel_init(softTimerWheel_t*)
+ * @brief Initialize an empty wheel starting at the current tick
+ * @param wheel Pointer to timer wheel
+ */
+void softTimerWheel_init(softTimerWheel_t *wheel)
+{
+    for (uint32_t i = 0; i < SOFTTIMER_WHEEL_SLOTS; i++) {
+        wheel->slots[i] = NULL;
+    }
+    wheel->lastTick = SOFTTIMER_TICK();
+}
+
+/**
+ * @fn    void softTimerWheel_initNode(softTimerNode_t*, softTimerCallback_t, void*)
+ * @brief Initialize a stopped wheel timer
+ * @param node     Pointer to timer node
+ * @param callback Called when the timer expires
+ * @param context  User data for the callback
+ */
+void softTimerWheel_initNode(softTimerNode_t *node,
+        softTimerCallback_t callback, void *context)
+{
+    node->next = NULL;
+    node->pprev = NULL;
+    node->deadline = 0;
+    node->callback = callback;
+    node->context = context;
+}
+
+/**
+ * @fn    void softTimerWheel_start(softTimerWheel_t*, softTimerNode_t*, uint32_t, uint32_t)
+ * @brief (Re)start a timer to expire timeout ticks after a given tick
+ * @param wheel   Pointer to timer wheel
+ * @param node    Pointer to timer node, restarted if already running
+ * @param now     Tick the timeout counts from
+ * @param timeout Timeout in ticks (SOFTTIMER_MS_TO_TICKS)
+ */
+void softTimerWheel_start(softTimerWheel_t *wheel, softTimerNode_t *node,
+        uint32_t now, uint32_t timeout)
+{
+    uint32_t deadline = now + timeout;
+    softTimerNode_t **head;
+
+    softTimerWheel_stop(node);
+
+    /* the slot of an already processed tick would wait a full revolution */
+    if ((int32_t)(deadline - wheel->lastTick) <= 0) {
+        deadline = wheel->lastTick + 1U;
+    }
+
+    node->deadline = deadline;
+    head = &wheel->slots[SOFTTIMER_WHEEL_SLOT(deadline)];
+    node->next = *head;
+    if (*head != NULL) {
+        (*head)->pprev = &node->next;
+    }
+    node->pprev = head;
+    *head = node;
+}
+
+/**
+ * @fn    void softTimerWheel_stop(softTimerNode_t*)
+ * @brief Stop a timer, no-op if it is not running
+ * @param node Pointer to timer node
+ */
+void softTimerWheel_stop(softTimerNode_t *node)
+{
+    if (node->pprev == NULL) {
+        return;
+    }
+
+    *node->pprev = node->next;
+    if (node->next != NULL) {
+        node->next->pprev = node->pprev;
+    }
+    node->next = NULL;
+    node->pprev = NULL;
+}
+
+/**
+ * @fn    void softTimerWheel_process(softTimerWheel_t*, uint32_t)
+ * @brief Expire every timer due up to a given tick
+ * @param wheel Pointer to timer wheel
+ * @param now   Current tick, e.g. SOFTTIMER_TICK()
+ */
+void softTimerWheel_process(softTimerWheel_t *wheel, uint32_t now)
+{
+    uint32_t elapsed = now - wheel->lastTick;
+
+    /* late by more than a revolution: every slot is due once */
+    if (elapsed >= SOFTTIMER_WHEEL_SLOTS) {
+        wheel->lastTick = now;
+        for (uint32_t slot = 0; slot < SOFTTIMER_WHEEL_SLOTS; slot++) {
+            softTimerWheel_expireSlot(wheel, slot, now);
+        }
+        return;
+    }
+
+    while (wheel->lastTick != now) {
+        wheel->lastTick++;
+        softTimerWheel_expireSlot(wheel,
+                SOFTTIMER_WHEEL_SLOT(wheel->lastTick), wheel->lastTick);
+    }
+}
+
+/**
+ * @fn    bool softTimerWheel_nextDeadline(const softTimerWheel_t*, uint32_t*)
+ * @brief Find the earliest deadline of all running timers
+ * @param wheel    Pointer to timer wheel
+ * @param deadline Pointer to store the earliest deadline tick
+ * @return true if a timer is running, false if the wheel is empty
+ */
+bool softTimerWheel_nextDeadline(const softTimerWheel_t *wheel,
+        uint32_t *deadline)
+{
+    bool isRunning = false;
+
+    for (uint32_t slot = 0; slot < SOFTTIMER_WHEEL_SLOTS; slot++) {
+        for (const softTimerNode_t *node = wheel->slots[slot]; node != NULL;
+                node = node->next) {
+            if (!isRunning
+                    || (int32_t)(node->deadline - *deadline) < 0) {
+                *deadline = node->deadline;
+                isRunning = true;
+            }
+        }
+    }
+
+    return isRunning;
+}
+
+/************************ (C) COPYRIGHT KeyhanSalehi *****END OF FILE****/
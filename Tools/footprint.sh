@@ -0,0 +1,116 @@
+#!/bin/sh
+# ******************************************************************************
+# @file           : footprint.sh
+# @author         : KeyhanSalehi
+# @brief          : RAM/flash footprint report of the Button Handler variants.
+# ******************************************************************************
+# @attention
+#
+# Compiles each engine variant for each reference CPU and prints the
+# .text/.data/.bss of its objects, plus the RAM every extra button (and,
+# for the bank engines, every extra port of 16 buttons) adds.
+#
+# Without HAL_INC the library is built against host_sim.h, which needs no
+# CubeMX project; the DMA variant needs the real HAL and is skipped then.
+#
+#   Tools/footprint.sh                       # from the repository root
+#   HAL_INC="-ICore/Inc -IDrivers/STM32F4xx_HAL_Driver/Inc \
+#            -IDrivers/CMSIS/Device/ST/STM32F4xx/Include -IDrivers/CMSIS/Include" \
+#       CPUS=cortex-m4 Tools/footprint.sh
+#
+# Environment: CC, SIZE, NM (default arm-none-eabi-*), CPUS (default
+# "cortex-m0 cortex-m4", "native" builds for the host), CFLAGS (extra flags,
+# e.g. -DPUSH_COUNT_MAX=10), HAL_INC (include flags of a CubeMX project).
+#
+# ******************************************************************************
+
+set -e
+
+ROOT=$(cd "$(dirname "$0")/.." && pwd)
+CC=${CC:-arm-none-eabi-gcc}
+SIZE=${SIZE:-arm-none-eabi-size}
+NM=${NM:-arm-none-eabi-nm}
+CPUS=${CPUS:-"cortex-m0 cortex-m4"}
+OPT=${OPT:--Os}
+
+if [ -n "$HAL_INC" ]; then
+	INC="$HAL_INC -I$ROOT/Inc"
+else
+	INC="-DHOST_SIM=1 -I$ROOT/Inc"
+fi
+
+WORK=$(mktemp -d)
+trap 'rm -rf "$WORK"' EXIT
+
+CORE="button_handler.c button_event.c softTimer.c"
+
+# name|defines|extra sources
+VARIANTS="poll||
+compact|-DBUTTON_COMPACT_LAYOUT=1|
+exti|-DBUTTON_EXTI_ENABLE=1|
+bank||button_bank.c
+vcounter|-DBUTTON_BANK_ENGINE=1|button_bank.c
+dma|-DBUTTON_DMA_ENABLE=1|button_bank.c button_dma.c"
+
+# sizes of the structures every button or port adds, read back from the symbols
+cat > "$WORK/probe.c" <<'EOF'
+#include "button_bank.h"
+Button_t footprintButton;
+ButtonBankPort_t footprintPort;
+EOF
+
+# symbolSize <object> <symbol>: prints the size of a symbol in bytes
+symbolSize() {
+	"$NM" -S "$1" | awk -v name="$2" '$NF == name { printf "%d\n", "0x" $2 }'
+}
+
+# reportVariant <cpu> <name> <defines> <extra sources>: builds and prints one row
+reportVariant() {
+	dir="$WORK/$1-$2"
+	mkdir -p "$dir"
+	flags="$ARCH $OPT -std=c11 -ffunction-sections -fdata-sections -fno-common $3 $CFLAGS $INC"
+
+	# e.g. the compact layout rejects most options given in CFLAGS
+	for src in $CORE $4 probe.c; do
+		case $src in
+		probe.c) path="$WORK/probe.c" ;;
+		*) path="$ROOT/Src/$src" ;;
+		esac
+		# shellcheck disable=SC2086
+		if ! $CC $flags -c "$path" -o "$dir/${src%.c}.o" 2> "$dir/errors"; then
+			printf '%-10s %-9s %s\n' "$1" "$2" "(does not build: $(grep -m 1 error "$dir/errors" | sed 's/.*error: //'))"
+			return 0
+		fi
+	done
+
+	button=$(symbolSize "$dir/probe.o" footprintButton)
+	case " $4 " in
+	*" button_bank.c "*) port=$(symbolSize "$dir/probe.o" footprintPort) ;;
+	*) port="-" ;;
+	esac
+
+	"$SIZE" -t "$dir"/button_*.o "$dir"/softTimer.o | tail -n 1 \
+		| awk -v cpu="$1" -v name="$2" -v button="$button" -v port="$port" \
+			'{ printf "%-10s %-9s %7s %6s %6s %8s %8s\n", cpu, name, $1, $2, $3, button, port }'
+}
+
+printf '%-10s %-9s %7s %6s %6s %8s %8s\n' \
+	"cpu" "variant" ".text" ".data" ".bss" "B/button" "B/port"
+
+for cpu in $CPUS; do
+	if [ "$cpu" = native ]; then
+		ARCH=""
+	else
+		ARCH="-mcpu=$cpu -mthumb"
+	fi
+
+	echo "$VARIANTS" | while IFS='|' read -r name defines extra; do
+		if [ "$name" = dma ] && [ -z "$HAL_INC" ]; then
+			printf '%-10s %-9s %s\n' "$cpu" "$name" "(needs HAL_INC)"
+		else
+			reportVariant "$cpu" "$name" "$defines" "$extra"
+		fi
+	done
+done
+
+# ******************** (C) COPYRIGHT [KeyhanSalehi] *****END OF FILE**********
@@ -0,0 +1,430 @@
+/**
+ ******************************************************************************
+ * @file           : host_replay.c
+ * @author         : KeyhanSalehi
+ * @brief          : Host replay regression and throughput run of the engine.
+ ******************************************************************************
+ * @attention
+ *
+ * Built by Tools/Makefile against host_sim.h. Every case loads a recorded
+ * dump with ButtonTrace_Load, replays it through a polled and an EXTI
+ * button with ButtonTrace_Replay and compares the counts both report with
+ * the expected ones. A long synthetic trace is then replayed to print the
+ * edges per second the engine handles on this host.
+ *
+ * The exit status is the number of failed cases.
+ *
+ ******************************************************************************
+ */
+
+/* Includes ------------------------------------------------------------------*/
+
+/* 1. System Header Files */
+#include <stdio.h>
+#include <time.h>
+
+/* 2. Project Header Files */
+#include "button_trace.h"
+
+/* Defines & Macros ----------------------------------------------------------*/
+/**
+ * @brief Constants and macros specific to this file.
+ */
+
+/*! @def @brief most counts a case may report. */
+#define REPLAY_MAX_COUNTS 8U
+
+/*! @def @brief records of the largest dump. */
+#define REPLAY_MAX_RECORDS 64U
+
+/*! @def @brief clicks of the throughput trace (4 records each). */
+#define REPLAY_BENCH_CLICKS 20000U
+
+/*! @def @brief edges of each bounce burst, more than the EXTI queue holds. */
+#define REPLAY_BURST_EDGES 13U
+
+/*! @def @brief counts of the overflow case, an early resolve closes at the max. */
+#if BUTTON_EARLY_RESOLVE
+#define REPLAY_OVERFLOW_COUNTS { 5U, 1U }, 2U
+#else
+#define REPLAY_OVERFLOW_COUNTS { 0U }, 0U
+#endif
+
+/*! @def @brief pin of the replayed button, on GPIOB with a pull-up. */
+#define REPLAY_PIN GPIO_PIN_1
+
+/* Typedefs ------------------------------------------------------------------*/
+/**
+ * @brief Typedefs for local use in this file.
+ */
+
+/*!
+ * @struct
+ * @brief Recorded dump and the counts it must give.
+ */
+typedef struct {
+	const char *name; /**< Case name in the report. */
+	const char *dump; /**< Text written by ButtonTrace_Dump. */
+	uint8_t expected[REPLAY_MAX_COUNTS]; /**< Counts in reporting order. */
+	uint8_t expectedCount; /**< Number of expected counts. */
+} ReplayCase_t;
+
+/* Variables -----------------------------------------------------------------*/
+
+/* 1. Global Variables */
+
+/* 2. Static Variables */
+
+/*! @brief recorded dumps, level in bit 15 (pull-up: 0 is pressed). */
+static const ReplayCase_t replayCases[] = {
+	{ "clean click", "BTRACE 2 0 2\n0064\n8050\nEND\n", { 1U }, 1U },
+	{ "bouncy double click",
+			"BTRACE 2 0 10\n0064\n8002\n0001\n8001\n0002\n8078\n00C8\n8001\n"
+			"0001\n805A\nEND\n", { 2U }, 1U },
+	{ "bounce inside debounce",
+			"BTRACE 2 0 6\n0064\n8014\n0005\n8005\n0005\n8050\nEND\n",
+			{ 1U }, 1U },
+	{ "two sequences",
+			"BTRACE 2 0 8\n0064\n8050\n0064\n8050\n0FA0\n8050\n0064\n8050\n"
+			"END\n", { 2U, 2U }, 2U },
+	{ "idle gap of 65 s",
+			"BTRACE 2 0 6\n0064\n8050\n7FFF\n0002\n0064\n8050\nEND\n",
+			{ 1U, 1U }, 2U },
+	{ "overflow",
+			"BTRACE 2 0 12\n0064\n8050\n0064\n8050\n0064\n8050\n0064\n8050\n"
+			"0064\n8050\n0064\n8050\nEND\n", REPLAY_OVERFLOW_COUNTS },
+};
+
+/*! @brief counts reported by the replay in progress. */
+static uint8_t replayCounts[REPLAY_MAX_COUNTS];
+static uint32_t replayCountTotal = 0;
+
+#if BUTTON_TIMER_WHEEL_ENABLE
+/*! @brief wheel of the sequence timeouts. */
+static softTimerWheel_t replayWheel;
+#endif
+
+/*! @brief records of the throughput trace. */
+static uint16_t replayBenchRecords[REPLAY_BENCH_CLICKS * 4U];
+
+/* Function Declarations -----------------------------------------------------*/
+
+/* 1. Local Prototype Functions */
+
+/*! @fn @private */
+static void Replay_OnResult(uint32_t tick, uint8_t count);
+/*! @fn @private */
+static void Replay_Reset(Button_t *button, bool isExti);
+/*! @fn @private */
+static bool Replay_Check(const ReplayCase_t *replay, bool isExti);
+#if BUTTON_EXTI_ENABLE
+/*! @fn @private */
+static bool Replay_EdgeBurst(void);
+#endif
+#if BUTTON_EARLY_RESOLVE
+/*! @fn @private */
+static bool Replay_HeldPress(void);
+#endif
+#if BUTTON_EXTI_ENABLE && BUTTON_TIMER_WHEEL_ENABLE
+/*! @fn @private */
+static bool Replay_LatePoll(void);
+#endif
+/*! @fn @private */
+static bool Replay_Throughput(void);
+
+/* 2. Global Function Declarations */
+
+/*!
+ * @fn     int main(void).
+ * @brief  Runs every replay case on both sources, then the throughput run.
+ * @return int Number of failed cases.
+ */
+int main(void) {
+
+	/* Local variable & initial */
+	int failed = 0;
+
+	for (size_t i = 0; i < sizeof(replayCases) / sizeof(replayCases[0]); i++) {
+		failed += Replay_Check(&replayCases[i], false) ? 0 : 1;
+		failed += Replay_Check(&replayCases[i], true) ? 0 : 1;
+	}
+
+#if BUTTON_EXTI_ENABLE
+	failed += Replay_EdgeBurst() ? 0 : 1;
+#endif
+#if BUTTON_EARLY_RESOLVE
+	failed += Replay_HeldPress() ? 0 : 1;
+#endif
+#if BUTTON_EXTI_ENABLE && BUTTON_TIMER_WHEEL_ENABLE
+	failed += Replay_LatePoll() ? 0 : 1;
+#endif
+	failed += Replay_Throughput() ? 0 : 1;
+	printf("%s: %d failed\n", (failed == 0) ? "PASS" : "FAIL", failed);
+
+	return failed;
+}
+
+/* 3. Local Function Declarations */
+
+/*!
+ * @fn     static void Replay_OnResult(uint32_t tick, uint8_t count).
+ * @brief  Stores a count reported by ButtonTrace_Replay.
+ * @param  tick Virtual tick of the report.
+ * @param  count Reported count.
+ * @return void
+ */
+static void Replay_OnResult(uint32_t tick, uint8_t count) {
+	(void) tick;
+
+	if (replayCountTotal < REPLAY_MAX_COUNTS) {
+		replayCounts[replayCountTotal] = count;
+	}
+	replayCountTotal++;
+}
+
+/*!
+ * @fn     static void Replay_Reset(Button_t *button, bool isExti).
+ * @brief  Restarts the simulation with a released button.
+ * @param  button Pointer to the Button_t structure.
+ * @param  isExti Capture the edges through the EXTI queue (true) or poll.
+ * @return void
+ */
+static void Replay_Reset(Button_t *button, bool isExti) {
+	HostSim_Reset();
+	HostSim_SetPort(GPIOB, 0xFFFFU);
+	HostSim_SetTick(1U);
+#if BUTTON_TIMER_WHEEL_ENABLE
+	softTimerWheel_init(&replayWheel);
+	Button_SetTimerWheel(&replayWheel);
+#endif
+	Button_Init(button, GPIOB, REPLAY_PIN, GPIO_PULLUP);
+#if BUTTON_EXTI_ENABLE
+	if (isExti) {
+		Button_EnableEXTI(button);
+	}
+#else
+	(void) isExti;
+#endif
+	replayCountTotal = 0;
+}
+
+/*!
+ * @fn     static bool Replay_Check(const ReplayCase_t *replay, bool isExti).
+ * @brief  Replays one dump and compares the reported counts.
+ * @param  replay Case to run.
+ * @param  isExti Capture the edges through the EXTI queue (true) or poll.
+ * @return bool true if the counts match.
+ */
+static bool Replay_Check(const ReplayCase_t *replay, bool isExti) {
+
+	/* Local variable & initial */
+	const char *source = isExti ? "exti" : "poll";
+	uint16_t records[REPLAY_MAX_RECORDS];
+	Button_t button;
+	uint8_t id = 0;
+	size_t count = ButtonTrace_Load(replay->dump, records, REPLAY_MAX_RECORDS,
+			&id);
+	bool isMatch = (count > 0U);
+
+#if !BUTTON_EXTI_ENABLE
+	if (isExti) {
+		return true;
+	}
+#endif
+
+	Replay_Reset(&button, isExti);
+	ButtonTrace_Replay(&button, records, count, Replay_OnResult);
+
+	isMatch = isMatch && (replayCountTotal == replay->expectedCount);
+	for (uint32_t i = 0; isMatch && i < replayCountTotal; i++) {
+		isMatch = (replayCounts[i] == replay->expected[i]);
+	}
+
+	printf("%s %-24s %s:", isMatch ? "ok  " : "FAIL", replay->name, source);
+	for (uint32_t i = 0; i < replayCountTotal && i < REPLAY_MAX_COUNTS; i++) {
+		printf(" %u", replayCounts[i]);
+	}
+	printf("\n");
+
+	return isMatch;
+}
+
+#if BUTTON_EXTI_ENABLE
+/*!
+ * @fn     static bool Replay_EdgeBurst(void).
+ * @brief  Overflows the EXTI queue with a bouncy click while the loop
+ *         stalls, then checks that the click and a clean one are counted.
+ * @return bool true if both clicks are counted.
+ */
+static bool Replay_EdgeBurst(void) {
+
+	/* Local variable & initial */
+	static const char dump[] = "BTRACE 2 0 2\n0800\n8050\nEND\n";
+	uint16_t records[REPLAY_MAX_RECORDS];
+	Button_t button;
+	uint8_t id = 0;
+	size_t count = ButtonTrace_Load(dump, records, REPLAY_MAX_RECORDS, &id);
+	bool isMatch;
+
+	Replay_Reset(&button, true);
+
+	/* press, then release bursts ending on their level, no poll in between */
+	for (uint32_t burst = 0; burst < 2U; burst++) {
+		HostSim_Advance(100U);
+		for (uint32_t i = 0; i < REPLAY_BURST_EDGES; i++) {
+			HostSim_SetPin(GPIOB, REPLAY_PIN,
+					((i + burst) % 2U == 0U) ? GPIO_PIN_RESET : GPIO_PIN_SET);
+			Button_EXTI_Callback(&button);
+			HostSim_Advance(1U);
+		}
+	}
+
+	/* the first poll replays the burst, a clean click follows 2 s later */
+	ButtonTrace_Replay(&button, records, count, Replay_OnResult);
+
+	isMatch = (replayCountTotal == 2U && replayCounts[0] == 1U
+			&& replayCounts[1] == 1U);
+	printf("%s %-24s exti:", isMatch ? "ok  " : "FAIL", "edge queue overflow");
+	for (uint32_t i = 0; i < replayCountTotal && i < REPLAY_MAX_COUNTS; i++) {
+		printf(" %u", replayCounts[i]);
+	}
+	printf("\n");
+
+	return isMatch;
+}
+#endif /* BUTTON_EXTI_ENABLE */
+
+#if BUTTON_EARLY_RESOLVE
+/*!
+ * @fn     static bool Replay_HeldPress(void).
+ * @brief  Feeds two clicks to a max count 1 button before its first early
+ *         result is read, as a bank scan does, and checks both are counted.
+ * @return bool true if two counts of 1 are read.
+ */
+static bool Replay_HeldPress(void) {
+
+	/* Local variable & initial */
+	Button_t button;
+	uint8_t count = 0;
+	bool isMatch;
+
+	Replay_Reset(&button, false);
+	button.source = BUTTON_SOURCE_EXTERNAL;
+	Button_SetMaxCount(&button, 1U);
+
+	Button_RegisterPress(&button, 100U);
+	Button_RegisterRelease(&button, 180U);
+	Button_RegisterPress(&button, 300U);
+	Button_RegisterRelease(&button, 380U);
+
+	for (uint32_t tick = 400U; tick < 400U + BUTTON_TIMEOUT_MS; tick++) {
+		HostSim_SetTick(tick);
+		if (Button_GetFinalCount(&button, &count) != return_busy) {
+			Replay_OnResult(tick, count);
+		}
+	}
+
+	isMatch = (replayCountTotal == 2U && replayCounts[0] == 1U
+			&& replayCounts[1] == 1U);
+	printf("%s %-24s ext:", isMatch ? "ok  " : "FAIL", "press before the read");
+	for (uint32_t i = 0; i < replayCountTotal && i < REPLAY_MAX_COUNTS; i++) {
+		printf(" %u", replayCounts[i]);
+	}
+	printf("\n");
+
+	return isMatch;
+}
+#endif /* BUTTON_EARLY_RESOLVE */
+
+#if BUTTON_EXTI_ENABLE && BUTTON_TIMER_WHEEL_ENABLE
+/*!
+ * @fn     static bool Replay_LatePoll(void).
+ * @brief  Lets the wheel expire the first deadline of a double click before
+ *         the stalled loop replays the second click, and checks that the
+ *         click still counts in the sequence.
+ * @return bool true if one count of 2 is read.
+ */
+static bool Replay_LatePoll(void) {
+
+	/* Local variable & initial */
+	static const uint32_t edges[] = { 180U, 400U, 480U };
+	Button_t button;
+	uint8_t count = 0;
+	bool isMatch;
+
+	Replay_Reset(&button, true);
+
+	/* the first press arms the deadline at 1100 */
+	HostSim_SetTick(100U);
+	HostSim_SetPin(GPIOB, REPLAY_PIN, GPIO_PIN_RESET);
+	Button_EXTI_Callback(&button);
+	(void) Button_GetFinalCount(&button, &count);
+
+	/* the loop stalls past that deadline while the second click is queued */
+	for (size_t i = 0; i < sizeof(edges) / sizeof(edges[0]); i++) {
+		HostSim_SetTick(edges[i]);
+		HostSim_SetPin(GPIOB, REPLAY_PIN, (i % 2U == 0U) ?
+				GPIO_PIN_SET : GPIO_PIN_RESET);
+		Button_EXTI_Callback(&button);
+	}
+
+	for (uint32_t tick = 1200U; tick < 1200U + 2U * BUTTON_TIMEOUT_MS; tick++) {
+		HostSim_SetTick(tick);
+		softTimerWheel_process(&replayWheel, tick);
+		if (Button_GetFinalCount(&button, &count) != return_busy) {
+			Replay_OnResult(tick, count);
+		}
+	}
+
+	isMatch = (replayCountTotal == 1U && replayCounts[0] == 2U);
+	printf("%s %-24s exti:", isMatch ? "ok  " : "FAIL", "wheel before late poll");
+	for (uint32_t i = 0; i < replayCountTotal && i < REPLAY_MAX_COUNTS; i++) {
+		printf(" %u", replayCounts[i]);
+	}
+	printf("\n");
+
+	return isMatch;
+}
+#endif /* BUTTON_EXTI_ENABLE && BUTTON_TIMER_WHEEL_ENABLE */
+
+/*!
+ * @fn     static bool Replay_Throughput(void).
+ * @brief  Replays a long bouncy trace and prints the edges per second.
+ * @return bool true if every click of the trace was counted.
+ */
+static bool Replay_Throughput(void) {
+
+	/* Local variable & initial */
+	size_t count = 0;
+	Button_t button;
+	clock_t start;
+	double seconds;
+	bool isMatch = true;
+
+	/* press, bounce, release, 1.5 s apart: every click closes alone */
+	for (uint32_t i = 0; i < REPLAY_BENCH_CLICKS; i++) {
+		replayBenchRecords[count++] = 0x05DCU;
+		replayBenchRecords[count++] = 0x8001U;
+		replayBenchRecords[count++] = 0x0001U;
+		replayBenchRecords[count++] = 0x8050U;
+	}
+
+	for (int exti = 0; exti <= BUTTON_EXTI_ENABLE; exti++) {
+		Replay_Reset(&button, exti != 0);
+		start = clock();
+		ButtonTrace_Replay(&button, replayBenchRecords, count, Replay_OnResult);
+		seconds = (double) (clock() - start) / CLOCKS_PER_SEC;
+
+		printf("bench %s: %u edges, %u ms simulated in %.3f s: %.0f edges/s,"
+				" %.0f polls/s%s\n", exti ? "exti" : "poll", (unsigned) count,
+				(unsigned) HAL_GetTick(), seconds,
+				(seconds > 0.0) ? (double) count / seconds : 0.0,
+				(seconds > 0.0) ? (double) HAL_GetTick() / seconds : 0.0,
+				(replayCountTotal == REPLAY_BENCH_CLICKS) ? "" : " (counts lost)");
+		isMatch = isMatch && (replayCountTotal == REPLAY_BENCH_CLICKS);
+	}
+
+	return isMatch;
+}
+
+/************************ (C) COPYRIGHT [KeyhanSalehi] *****END OF FILE****/